@@ -0,0 +1,260 @@
+/**
+ * @file /src/benchmark/Benchmark.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ */
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/config/Config.h"
+#include "src/touchegg/gestures/handler/GestureHandler.h"
+#include "src/touchegg/eventloop/EpollEventDispatcher.h"
+#include "src/benchmark/FakeX11.h"
+#include "src/benchmark/FrameGenerator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ****************************************************************************************************************** //
+// **********                                      ALLOCATION COUNTERS                                     ********** //
+// ****************************************************************************************************************** //
+
+extern "C" {
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t num, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+}
+
+namespace
+{
+    qint64 allocations = 0;
+    qint64 allocatedBytes = 0;
+}
+
+// Replace the allocator entry points of glibc to count the allocations made in the hot path, including the ones of
+// operator new, that uses malloc
+extern "C" void *malloc(size_t size)
+{
+    allocations++;
+    allocatedBytes += size;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t num, size_t size)
+{
+    allocations++;
+    allocatedBytes += num * size;
+    return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    allocations++;
+    allocatedBytes += size;
+    return __libc_realloc(ptr, size);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    const int DEFAULT_ITERATIONS  = 2000;
+    const int UPDATES_PER_GESTURE = 30;
+
+    const int CONFIG_APPS              = 500;
+    const int CONFIG_GESTURES_PER_APP  = 20;
+    const int CONFIG_PARSE_ITERATIONS  = 10;
+
+    /**
+     * Configuration used to run the gestures. The composed gestures time is 0 so taps are executed as soon as the
+     * event loop runs.
+     */
+    const char *BENCHMARK_CONFIG =
+        "<touchégg>\n"
+        "  <settings>\n"
+        "    <property name=\"composed_gestures_time\">0</property>\n"
+        "  </settings>\n"
+        "  <application name=\"All\">\n"
+        "    <gesture type=\"TAP\" fingers=\"2\" direction=\"\">\n"
+        "      <action type=\"MOUSE_CLICK\">BUTTON=1</action>\n"
+        "    </gesture>\n"
+        "    <gesture type=\"DRAG\" fingers=\"2\" direction=\"ALL\">\n"
+        "      <action type=\"SCROLL\">SPEED=7:INVERTED=false</action>\n"
+        "    </gesture>\n"
+        "    <gesture type=\"DRAG\" fingers=\"3\" direction=\"ALL\">\n"
+        "      <action type=\"MOVE_WINDOW\"></action>\n"
+        "    </gesture>\n"
+        "    <gesture type=\"PINCH\" fingers=\"2\" direction=\"ALL\">\n"
+        "      <action type=\"RESIZE_WINDOW\"></action>\n"
+        "    </gesture>\n"
+        "  </application>\n"
+        "</touchégg>\n";
+
+    /**
+     * Writes the content to a temporal file and returns its name.
+     */
+    QString writeTemporalFile(QTemporaryFile &file, const QByteArray &content)
+    {
+        file.open();
+        file.write(content);
+        file.close();
+        return file.fileName();
+    }
+
+    /**
+     * Generates a configuration with the indicated number of applications and gestures per application.
+     */
+    QByteArray generateConfig(int numApps, int gesturesPerApp)
+    {
+        static const char *directions[] = { "UP", "DOWN", "LEFT", "RIGHT" };
+
+        QByteArray ret;
+        ret.append("<touchégg>\n  <settings>\n");
+        ret.append("    <property name=\"composed_gestures_time\">200</property>\n  </settings>\n");
+        for (int app = 0; app < numApps; app++) {
+            ret.append(QString("  <application name=\"App%1,Alias%1\">\n").arg(app).toUtf8());
+            for (int gesture = 0; gesture < gesturesPerApp; gesture++) {
+                ret.append(QString("    <gesture type=\"DRAG\" fingers=\"%1\" direction=\"%2\">\n")
+                        .arg(gesture / 4 + 1).arg(directions[gesture % 4]).toUtf8());
+                ret.append("      <action type=\"SEND_KEYS\">Control+Alt+Left</action>\n    </gesture>\n");
+            }
+            ret.append("  </application>\n");
+        }
+        ret.append("</touchégg>\n");
+        return ret;
+    }
+
+    /**
+     * Runs the indicated scenario and prints the results.
+     */
+    void runScenario(GestureHandler &handler, FrameGenerator::Scenario scenario, int iterations)
+    {
+        // Generate all the frames before the measure
+        QList<QList<FrameGenerator::Frame> > gestures;
+        for (int n = 0; n < iterations; n++)
+            gestures.append(FrameGenerator::generate(scenario, n, UPDATES_PER_GESTURE,
+                    FakeX11::FIRST_CLIENT_WINDOW));
+
+        FakeX11::reset();
+        allocations = 0;
+        allocatedBytes = 0;
+        int numFrames = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int n = 0; n < iterations; n++) {
+            const QList<FrameGenerator::Frame> &frames = gestures.at(n);
+            for (int f = 0; f < frames.size(); f++) {
+                const FrameGenerator::Frame &frame = frames.at(f);
+                switch (frame.phase) {
+                case FrameGenerator::Frame::START:
+                    handler.executeGestureStart(frame.type, frame.id, frame.attrs);
+                    break;
+                case FrameGenerator::Frame::UPDATE:
+                    handler.executeGestureUpdate(frame.type, frame.id, frame.attrs);
+                    break;
+                case FrameGenerator::Frame::FINISH:
+                    handler.executeGestureFinish(frame.type, frame.id, frame.attrs);
+                    break;
+                }
+            }
+            numFrames += frames.size();
+
+            // Run the pending timers (taps)
+            QCoreApplication::processEvents();
+        }
+
+        qint64 elapsed = qMax(timer.nsecsElapsed(), (qint64)1);
+
+        printf("%-8s %10.0f frames/s %8.2f allocs/frame %10.1f bytes/frame %7.2f requests/gesture "
+                "%7.2f round trips/gesture %6.2f flushes/gesture\n",
+                qPrintable(FrameGenerator::getName(scenario)),
+                numFrames * 1e9 / elapsed,
+                (double)allocations / numFrames,
+                (double)allocatedBytes / numFrames,
+                (double)FakeX11::requests / iterations,
+                (double)FakeX11::roundTrips / iterations,
+                (double)FakeX11::flushes / iterations);
+    }
+
+    /**
+     * Measures the parsing of a big configuration file.
+     */
+    void runConfigParse()
+    {
+        QTemporaryFile file;
+        QString fileName = writeTemporalFile(file, generateConfig(CONFIG_APPS, CONFIG_GESTURES_PER_APP));
+
+        allocations = 0;
+        allocatedBytes = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int n = 0; n < CONFIG_PARSE_ITERATIONS; n++)
+            Config::loadConfig(fileName);
+        qint64 elapsed = timer.nsecsElapsed();
+
+        printf("config   %10.3f ms/parse %10lld allocs/parse %10lld bytes/parse (%d applications, %d gestures)\n",
+                elapsed / 1e6 / CONFIG_PARSE_ITERATIONS,
+                allocations / CONFIG_PARSE_ITERATIONS,
+                allocatedBytes / CONFIG_PARSE_ITERATIONS,
+                CONFIG_APPS, CONFIG_APPS * CONFIG_GESTURES_PER_APP);
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                             MAIN                                             ********** //
+// ****************************************************************************************************************** //
+
+/**
+ * Runs the gesture pipeline (GestureHandler, gestures and actions) over synthetic frames against a fake X server,
+ * without touch devices, X server or GEIS.
+ *
+ * Usage: touchegg-benchmark [--epoll] [iterations]
+ */
+int main(int argc, char **argv)
+{
+    // "--epoll" runs the event loop with the EpollEventDispatcher, it must be created before the application
+    for (int n = 1; n < argc; n++) {
+        if (strcmp(argv[n], "--epoll") == 0)
+            new EpollEventDispatcher();
+    }
+
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+    args.removeAll("--epoll");
+
+    int iterations = DEFAULT_ITERATIONS;
+    if (args.size() > 1)
+        iterations = qMax(1, args.at(1).toInt());
+
+    runConfigParse();
+
+    QTemporaryFile configFile;
+    Config::loadConfig(writeTemporalFile(configFile, BENCHMARK_CONFIG));
+
+    GestureHandler handler;
+    runScenario(handler, FrameGenerator::SCROLL, iterations);
+    runScenario(handler, FrameGenerator::DRAG, iterations);
+    runScenario(handler, FrameGenerator::PINCH, iterations);
+    runScenario(handler, FrameGenerator::TAP, iterations);
+
+    return 0;
+}
@@ -0,0 +1,425 @@
+/**
+ * @file /src/benchmark/FakeX11.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  FakeX11
+ */
+#include "FakeX11.h"
+#include <cstdlib>
+#include <cstring>
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    const unsigned long NUM_DESKTOPS = 4;
+
+    /**
+     * Atoms interned in the fake server.
+     */
+    QHash<QString, Atom> atoms;
+
+    QString atomName(Atom atom)
+    {
+        return atoms.key(atom);
+    }
+
+    /**
+     * XCB requests waiting for their reply. A round trip is counted when the client waits for a reply that the fake
+     * server has not sent yet, and it answers all the requests sent until then, like the real server.
+     */
+    struct XcbRequest {
+        xcb_atom_t atom;
+        xcb_atom_t type;
+        QByteArray name;
+    };
+
+    QHash<unsigned int, XcbRequest> xcbRequests;
+    unsigned int lastSequence = 0;
+    unsigned int lastAnswered = 0;
+
+    unsigned int sendXcbRequest(const XcbRequest &request)
+    {
+        FakeX11::requests++;
+        xcbRequests.insert(++lastSequence, request);
+        return lastSequence;
+    }
+
+    XcbRequest takeXcbRequest(unsigned int sequence)
+    {
+        if (sequence > lastAnswered) {
+            FakeX11::roundTrips++;
+            lastAnswered = lastSequence;
+        }
+        return xcbRequests.take(sequence);
+    }
+
+    xcb_get_property_reply_t *propertyReply(xcb_atom_t type, int format, const void *data, int length)
+    {
+        // The client frees the replies with free and the value is stored after the reply, like in XCB
+        int size = length * format / 8;
+        xcb_get_property_reply_t *reply = (xcb_get_property_reply_t *)calloc(1, sizeof(xcb_get_property_reply_t)
+                + size);
+        reply->type      = type;
+        reply->format    = format;
+        reply->value_len = length;
+        memcpy(reply + 1, data, size);
+        return reply;
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+const char *FakeX11::WINDOW_CLASS = "Benchmark";
+
+int FakeX11::requests    = 0;
+int FakeX11::roundTrips  = 0;
+int FakeX11::flushes     = 0;
+int FakeX11::inputEvents = 0;
+
+void FakeX11::reset()
+{
+    FakeX11::requests    = 0;
+    FakeX11::roundTrips  = 0;
+    FakeX11::flushes     = 0;
+    FakeX11::inputEvents = 0;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         XLIB / XTEST                                         ********** //
+// ****************************************************************************************************************** //
+
+extern "C" {
+
+Display *XOpenDisplay(const char *)
+{
+    // Only used as a handle, the fake server doesn't read it
+    static char display[1];
+    return (Display *)display;
+}
+
+int XCloseDisplay(Display *)
+{
+    return 0;
+}
+
+int XDefaultScreen(Display *)
+{
+    return 0;
+}
+
+Window XRootWindow(Display *, int)
+{
+    return FakeX11::ROOT_WINDOW;
+}
+
+int XDisplayWidth(Display *, int)
+{
+    return 1920;
+}
+
+int XDisplayHeight(Display *, int)
+{
+    return 1080;
+}
+
+int XDisplayWidthMM(Display *, int)
+{
+    // 96 DPI
+    return 508;
+}
+
+XErrorHandler XSetErrorHandler(XErrorHandler)
+{
+    // The fake server doesn't send errors
+    return NULL;
+}
+
+int XGetErrorText(Display *, int, char *buffer, int length)
+{
+    if (length > 0)
+        buffer[0] = '\0';
+    return 0;
+}
+
+int XConnectionNumber(Display *)
+{
+    return -1;
+}
+
+int XSelectInput(Display *, Window, long)
+{
+    FakeX11::requests++;
+    return 1;
+}
+
+int XPending(Display *)
+{
+    return 0;
+}
+
+int XNextEvent(Display *, XEvent *event)
+{
+    memset(event, 0, sizeof(XEvent));
+    return 0;
+}
+
+int XFlush(Display *)
+{
+    FakeX11::flushes++;
+    return 1;
+}
+
+Bool XQueryPointer(Display *, Window, Window *rootReturn, Window *childReturn, int *rootX, int *rootY, int *winX,
+        int *winY, unsigned int *mask)
+{
+    FakeX11::requests++;
+    FakeX11::roundTrips++;
+
+    *rootReturn  = FakeX11::ROOT_WINDOW;
+    *childReturn = FakeX11::FIRST_CLIENT_WINDOW;
+    *rootX = *winX = 100;
+    *rootY = *winY = 100;
+    *mask  = 0;
+    return True;
+}
+
+Status XGetWindowAttributes(Display *, Window, XWindowAttributes *attributes)
+{
+    FakeX11::requests++;
+    FakeX11::roundTrips++;
+
+    memset(attributes, 0, sizeof(XWindowAttributes));
+    attributes->width  = 800;
+    attributes->height = 600;
+    return 1;
+}
+
+int XResizeWindow(Display *, Window, unsigned int, unsigned int)
+{
+    FakeX11::requests++;
+    return 1;
+}
+
+KeySym XStringToKeysym(const char *string)
+{
+    // Any non-zero value is valid for the fake server
+    return string[0];
+}
+
+KeyCode XKeysymToKeycode(Display *, KeySym keySym)
+{
+    return (KeyCode)(keySym & 0xFF);
+}
+
+int XTestFakeKeyEvent(Display *, unsigned int, Bool, unsigned long)
+{
+    FakeX11::requests++;
+    FakeX11::inputEvents++;
+    return 1;
+}
+
+int XTestFakeButtonEvent(Display *, unsigned int, Bool, unsigned long)
+{
+    FakeX11::requests++;
+    FakeX11::inputEvents++;
+    return 1;
+}
+
+int XTestFakeRelativeMotionEvent(Display *, int, int, unsigned long)
+{
+    FakeX11::requests++;
+    FakeX11::inputEvents++;
+    return 1;
+}
+
+char *XGetAtomName(Display *, Atom)
+{
+    FakeX11::requests++;
+    FakeX11::roundTrips++;
+    return NULL;
+}
+
+int XFree(void *data)
+{
+    free(data);
+    return 1;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                            XRANDR                                            ********** //
+// ****************************************************************************************************************** //
+
+// The fake server doesn't have XRandR, so the whole screen is one monitor
+
+Bool XRRQueryExtension(Display *, int *, int *)
+{
+    return False;
+}
+
+void XRRSelectInput(Display *, Window, int)
+{
+    FakeX11::requests++;
+}
+
+int XRRUpdateConfiguration(XEvent *)
+{
+    return 0;
+}
+
+XRRMonitorInfo *XRRGetMonitors(Display *, Window, Bool, int *numMonitors)
+{
+    FakeX11::requests++;
+    FakeX11::roundTrips++;
+    *numMonitors = 0;
+    return NULL;
+}
+
+void XRRFreeMonitors(XRRMonitorInfo *)
+{
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                             XCB                                              ********** //
+// ****************************************************************************************************************** //
+
+xcb_connection_t *XGetXCBConnection(Display *display)
+{
+    // Only used as a handle, like the Display
+    return (xcb_connection_t *)display;
+}
+
+int xcb_flush(xcb_connection_t *)
+{
+    FakeX11::flushes++;
+    return 1;
+}
+
+xcb_intern_atom_cookie_t xcb_intern_atom(xcb_connection_t *, uint8_t, uint16_t nameLength, const char *name)
+{
+    XcbRequest request;
+    request.atom = XCB_ATOM_NONE;
+    request.type = XCB_ATOM_NONE;
+    request.name = QByteArray(name, nameLength);
+
+    xcb_intern_atom_cookie_t cookie;
+    cookie.sequence = sendXcbRequest(request);
+    return cookie;
+}
+
+xcb_intern_atom_reply_t *xcb_intern_atom_reply(xcb_connection_t *, xcb_intern_atom_cookie_t cookie,
+        xcb_generic_error_t **)
+{
+    QString name = takeXcbRequest(cookie.sequence).name;
+    if (!atoms.contains(name))
+        atoms.insert(name, atoms.size() + 1000);
+
+    xcb_intern_atom_reply_t *reply = (xcb_intern_atom_reply_t *)calloc(1, sizeof(xcb_intern_atom_reply_t));
+    reply->atom = atoms.value(name);
+    return reply;
+}
+
+xcb_get_property_cookie_t xcb_get_property(xcb_connection_t *, uint8_t, xcb_window_t, xcb_atom_t property,
+        xcb_atom_t type, uint32_t, uint32_t)
+{
+    XcbRequest request;
+    request.atom = property;
+    request.type = type;
+
+    xcb_get_property_cookie_t cookie;
+    cookie.sequence = sendXcbRequest(request);
+    return cookie;
+}
+
+xcb_get_property_reply_t *xcb_get_property_reply(xcb_connection_t *, xcb_get_property_cookie_t cookie,
+        xcb_generic_error_t **)
+{
+    XcbRequest request = takeXcbRequest(cookie.sequence);
+    QString name = atomName(request.atom);
+
+    if (request.atom == XCB_ATOM_WM_CLASS) {
+        QByteArray wmClass = QByteArray(FakeX11::WINDOW_CLASS) + '\0' + FakeX11::WINDOW_CLASS + '\0';
+        return propertyReply(XCB_ATOM_STRING, 8, wmClass.constData(), wmClass.size());
+
+    } else if (name == "_NET_CLIENT_LIST_STACKING" || name == "_NET_CLIENT_LIST") {
+        quint32 windows[FakeX11::NUM_CLIENT_WINDOWS];
+        for (int n = 0; n < FakeX11::NUM_CLIENT_WINDOWS; n++)
+            windows[n] = FakeX11::FIRST_CLIENT_WINDOW + n;
+        return propertyReply(request.type, 32, windows, FakeX11::NUM_CLIENT_WINDOWS);
+
+    } else if (name == "_NET_NUMBER_OF_DESKTOPS") {
+        quint32 numDesktops = NUM_DESKTOPS;
+        return propertyReply(request.type, 32, &numDesktops, 1);
+
+    } else if (name == "_NET_CURRENT_DESKTOP" || name == "_NET_SHOWING_DESKTOP") {
+        quint32 zero = 0;
+        return propertyReply(request.type, 32, &zero, 1);
+    }
+
+    return propertyReply(XCB_ATOM_NONE, 0, NULL, 0);
+}
+
+void *xcb_get_property_value(const xcb_get_property_reply_t *reply)
+{
+    return (void *)(reply + 1);
+}
+
+int xcb_get_property_value_length(const xcb_get_property_reply_t *reply)
+{
+    return reply->value_len * (reply->format / 8);
+}
+
+xcb_query_tree_cookie_t xcb_query_tree(xcb_connection_t *, xcb_window_t)
+{
+    XcbRequest request;
+    request.atom = XCB_ATOM_NONE;
+    request.type = XCB_ATOM_NONE;
+
+    xcb_query_tree_cookie_t cookie;
+    cookie.sequence = sendXcbRequest(request);
+    return cookie;
+}
+
+xcb_query_tree_reply_t *xcb_query_tree_reply(xcb_connection_t *, xcb_query_tree_cookie_t cookie,
+        xcb_generic_error_t **)
+{
+    // All the windows are top-level windows
+    takeXcbRequest(cookie.sequence);
+    xcb_query_tree_reply_t *reply = (xcb_query_tree_reply_t *)calloc(1, sizeof(xcb_query_tree_reply_t));
+    reply->root   = FakeX11::ROOT_WINDOW;
+    reply->parent = FakeX11::ROOT_WINDOW;
+    return reply;
+}
+
+xcb_void_cookie_t xcb_send_event(xcb_connection_t *, uint8_t, xcb_window_t, uint32_t, const char *)
+{
+    FakeX11::requests++;
+
+    xcb_void_cookie_t cookie;
+    cookie.sequence = ++lastSequence;
+    return cookie;
+}
+
+}
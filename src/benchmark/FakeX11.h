@@ -0,0 +1,87 @@
+/**
+ * @file /src/benchmark/FakeX11.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  FakeX11
+ */
+#ifndef FAKEX11_H
+#define FAKEX11_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Fake X server used by the benchmark. FakeX11.cpp defines the Xlib, XTest, XRandR and XCB functions used by Touchégg,
+ * so they are linked instead of the real ones: the input events are discarded, the replies are synthesized and every
+ * call is counted.
+ *
+ * The windows of the fake server are all top-level and are listed in _NET_CLIENT_LIST_STACKING.
+ */
+class FakeX11
+{
+
+public:
+
+    /**
+     * Root window of the fake server.
+     */
+    static const Window ROOT_WINDOW = 1;
+
+    /**
+     * First window of _NET_CLIENT_LIST_STACKING.
+     */
+    static const Window FIRST_CLIENT_WINDOW = 0x100;
+
+    /**
+     * Number of windows in _NET_CLIENT_LIST_STACKING.
+     */
+    static const int NUM_CLIENT_WINDOWS = 16;
+
+    /**
+     * Class of all the windows.
+     */
+    static const char *WINDOW_CLASS;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Number of requests sent to the server, including the round trips.
+     */
+    static int requests;
+
+    /**
+     * Number of times the client waits for a reply. Several pipelined XCB requests are answered in one round trip.
+     */
+    static int roundTrips;
+
+    /**
+     * Number of XFlush and xcb_flush calls.
+     */
+    static int flushes;
+
+    /**
+     * Number of injected input events (XTest).
+     */
+    static int inputEvents;
+
+    /**
+     * Sets all the counters to 0.
+     */
+    static void reset();
+
+};
+
+#endif // FAKEX11_H
@@ -0,0 +1,100 @@
+/**
+ * @file /src/benchmark/FrameGenerator.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  FrameGenerator
+ */
+#include "FrameGenerator.h"
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+QString FrameGenerator::getName(Scenario scenario)
+{
+    switch (scenario) {
+    case FrameGenerator::SCROLL:
+        return "scroll";
+    case FrameGenerator::DRAG:
+        return "drag";
+    case FrameGenerator::PINCH:
+        return "pinch";
+    case FrameGenerator::TAP:
+        return "tap";
+    }
+
+    return QString();
+}
+
+QList<FrameGenerator::Frame> FrameGenerator::generate(Scenario scenario, int id, int numUpdates, Window window)
+{
+    QString type;
+    int numFingers;
+    switch (scenario) {
+    case FrameGenerator::SCROLL:
+        type = GEIS_GESTURE_DRAG;
+        numFingers = 2;
+        break;
+    case FrameGenerator::DRAG:
+        type = GEIS_GESTURE_DRAG;
+        numFingers = 3;
+        break;
+    case FrameGenerator::PINCH:
+        type = GEIS_GESTURE_PINCH;
+        numFingers = 2;
+        break;
+    case FrameGenerator::TAP:
+    default:
+        type = GEIS_GESTURE_TAP;
+        numFingers = 2;
+        numUpdates = 1;
+        break;
+    }
+
+    QHash<QString, QVariant> attrs;
+    attrs.insert(GEIS_GESTURE_ATTRIBUTE_GESTURE_NAME, type);
+    attrs.insert(GEIS_GESTURE_ATTRIBUTE_TOUCHES, numFingers);
+    attrs.insert(GEIS_GESTURE_ATTRIBUTE_CHILD_WINDOW_ID, (int)window);
+    attrs.insert(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_X, 100.0f);
+    attrs.insert(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_Y, 100.0f);
+
+    QList<Frame> ret;
+    for (int n = 0; n <= numUpdates + 1; n++) {
+        Frame frame;
+        frame.phase = (n == 0) ? Frame::START : (n <= numUpdates) ? Frame::UPDATE : Frame::FINISH;
+        frame.type  = type;
+        frame.id    = id;
+        frame.attrs = attrs;
+
+        // GEIS timestamps in milliseconds, of a device that reports 100 frames per second
+        frame.attrs.insert(GEIS_GESTURE_ATTRIBUTE_TIMESTAMP, n * 10);
+
+        // The first frame of a drag has no movement, like in the real devices. The rest of the frames move right,
+        // alternating the speed to exercise the acumulators of the actions. The deltas are already normalized to
+        // millimetres, as the collector does
+        if (scenario == FrameGenerator::SCROLL || scenario == FrameGenerator::DRAG) {
+            frame.attrs.insert(GEIS_GESTURE_ATTRIBUTE_DELTA_X, (n == 0) ? 0.0f : (n % 2 == 0) ? 3.0f : 1.5f);
+            frame.attrs.insert(GEIS_GESTURE_ATTRIBUTE_DELTA_Y, (n == 0) ? 0.0f : 0.25f);
+        } else if (scenario == FrameGenerator::PINCH) {
+            frame.attrs.insert(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA, 1.05f);
+        }
+
+        ret.append(frame);
+    }
+
+    return ret;
+}
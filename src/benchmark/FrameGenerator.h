@@ -0,0 +1,74 @@
+/**
+ * @file /src/benchmark/FrameGenerator.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  FrameGenerator
+ */
+#ifndef FRAMEGENERATOR_H
+#define FRAMEGENERATOR_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Generates synthetic GEIS frames, with the same attributes that GestureCollector sends to the GestureHandler, to feed
+ * the benchmark without a touch device.
+ */
+class FrameGenerator
+{
+
+public:
+
+    /**
+     * Gestures that can be generated.
+     */
+    enum Scenario {
+        SCROLL, ///< 2 fingers drag.
+        DRAG,   ///< 3 fingers drag.
+        PINCH,  ///< 2 fingers pinch.
+        TAP     ///< 2 fingers tap.
+    };
+
+    /**
+     * A frame of a gesture.
+     */
+    struct Frame {
+        enum Phase { START, UPDATE, FINISH } phase;
+        QString type;
+        int id;
+        QHash<QString, QVariant> attrs;
+    };
+
+    /**
+     * Returns the name of the scenario.
+     * @param  scenario The scenario.
+     * @return The name.
+     */
+    static QString getName(Scenario scenario);
+
+    /**
+     * Generates the frames of a complete gesture: a start, numUpdates updates and a finish.
+     * @param  scenario   The gesture to generate.
+     * @param  id         Gesture ID.
+     * @param  numUpdates Number of updates. Taps only have one update.
+     * @param  window     Window over the gesture is made.
+     * @return The frames, in order.
+     */
+    static QList<Frame> generate(Scenario scenario, int id, int numUpdates, Window window);
+
+};
+
+#endif // FRAMEGENERATOR_H
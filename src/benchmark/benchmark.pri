@@ -0,0 +1,8 @@
+HEADERS += \
+    src/benchmark/FakeX11.h \
+    src/benchmark/FrameGenerator.h
+
+SOURCES += \
+    src/benchmark/FakeX11.cpp \
+    src/benchmark/FrameGenerator.cpp \
+    src/benchmark/Benchmark.cpp
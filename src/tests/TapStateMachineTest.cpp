@@ -0,0 +1,260 @@
+/**
+ * @file /src/tests/TapStateMachineTest.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ */
+#include "TapStateMachineTest.h"
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    /**
+     * Composed gestures time used by the tests.
+     */
+    const int TIME = 300;
+
+    /**
+     * Fingers of the taps made by prepare() and other number of fingers.
+     */
+    const int FINGERS = 2;
+    const int OTHER_FINGERS = 3;
+
+    /**
+     * Time between two events inside the composed gestures time.
+     */
+    const int INTERVAL = 100;
+}
+
+Q_DECLARE_METATYPE(TapStateMachine::Event)
+Q_DECLARE_METATYPE(TapStateMachine::Output)
+
+
+// ****************************************************************************************************************** //
+// **********                                         PRIVATE SLOTS                                        ********** //
+// ****************************************************************************************************************** //
+
+void TapStateMachineTest::transitions_data()
+{
+    QTest::addColumn<int>("numTaps");
+    QTest::addColumn<TapStateMachine::Event>("event");
+    QTest::addColumn<int>("numFingers");
+    QTest::addColumn<int>("nextTaps");
+    QTest::addColumn<int>("firedTaps");
+    QTest::addColumn<TapStateMachine::Output>("output");
+
+    // IDLE: a tap starts a sequence, the rest of gestures run normally
+    QTest::newRow("IDLE, TAP_SAME_FINGERS")    << 0 << TapStateMachine::TAP     << FINGERS       << 1 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("IDLE, TAP_OTHER_FINGERS")   << 0 << TapStateMachine::TAP     << OTHER_FINGERS << 1 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("IDLE, DRAG_SAME_FINGERS")   << 0 << TapStateMachine::DRAG    << FINGERS       << 0 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("IDLE, DRAG_OTHER_FINGERS")  << 0 << TapStateMachine::DRAG    << OTHER_FINGERS << 0 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("IDLE, OTHER_GESTURE")       << 0 << TapStateMachine::OTHER   << FINGERS       << 0 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("IDLE, TIMEOUT_EXPIRED")     << 0 << TapStateMachine::TIMEOUT << 0             << 0 << 0
+            << TapStateMachine::NONE;
+
+    // ONE_TAP: waiting for a DOUBLE_TAP or a TAP_AND_HOLD
+    QTest::newRow("ONE_TAP, TAP_SAME_FINGERS")   << 1 << TapStateMachine::TAP     << FINGERS       << 2 << 0
+            << TapStateMachine::NONE;
+    QTest::newRow("ONE_TAP, TAP_OTHER_FINGERS")  << 1 << TapStateMachine::TAP     << OTHER_FINGERS << 1 << 1
+            << TapStateMachine::NONE;
+    QTest::newRow("ONE_TAP, DRAG_SAME_FINGERS")  << 1 << TapStateMachine::DRAG    << FINGERS       << 0 << 0
+            << TapStateMachine::HOLD;
+    QTest::newRow("ONE_TAP, DRAG_OTHER_FINGERS") << 1 << TapStateMachine::DRAG    << OTHER_FINGERS << 0 << 1
+            << TapStateMachine::NONE;
+    QTest::newRow("ONE_TAP, OTHER_GESTURE")      << 1 << TapStateMachine::OTHER   << FINGERS       << 0 << 1
+            << TapStateMachine::NONE;
+    QTest::newRow("ONE_TAP, TIMEOUT_EXPIRED")    << 1 << TapStateMachine::TIMEOUT << 0             << 0 << 1
+            << TapStateMachine::NONE;
+
+    // TWO_TAPS: waiting for a TRIPLE_TAP, the longest sequence
+    QTest::newRow("TWO_TAPS, TAP_SAME_FINGERS")   << 2 << TapStateMachine::TAP     << FINGERS       << 0 << 3
+            << TapStateMachine::NONE;
+    QTest::newRow("TWO_TAPS, TAP_OTHER_FINGERS")  << 2 << TapStateMachine::TAP     << OTHER_FINGERS << 1 << 2
+            << TapStateMachine::NONE;
+    QTest::newRow("TWO_TAPS, DRAG_SAME_FINGERS")  << 2 << TapStateMachine::DRAG    << FINGERS       << 0 << 2
+            << TapStateMachine::NONE;
+    QTest::newRow("TWO_TAPS, DRAG_OTHER_FINGERS") << 2 << TapStateMachine::DRAG    << OTHER_FINGERS << 0 << 2
+            << TapStateMachine::NONE;
+    QTest::newRow("TWO_TAPS, OTHER_GESTURE")      << 2 << TapStateMachine::OTHER   << FINGERS       << 0 << 2
+            << TapStateMachine::NONE;
+    QTest::newRow("TWO_TAPS, TIMEOUT_EXPIRED")    << 2 << TapStateMachine::TIMEOUT << 0             << 0 << 2
+            << TapStateMachine::NONE;
+}
+
+void TapStateMachineTest::transitions()
+{
+    QFETCH(int, numTaps);
+    QFETCH(TapStateMachine::Event, event);
+    QFETCH(int, numFingers);
+    QFETCH(int, nextTaps);
+    QFETCH(int, firedTaps);
+    QFETCH(TapStateMachine::Output, output);
+
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, numTaps);
+    QCOMPARE(machine.getNumTaps(), numTaps);
+
+    QCOMPARE(machine.next(event, numFingers, time + INTERVAL), output);
+    QCOMPARE(machine.getNumTaps(), nextTaps);
+    QCOMPARE(machine.getFiredTaps(), firedTaps);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void TapStateMachineTest::expiry_data()
+{
+    QTest::addColumn<int>("elapsed");
+    QTest::addColumn<int>("nextTaps");
+    QTest::addColumn<int>("firedTaps");
+
+    QTest::newRow("at the time")     << TIME     << 2 << 0;
+    QTest::newRow("after the time")  << TIME + 1 << 1 << 1;
+}
+
+void TapStateMachineTest::expiry()
+{
+    QFETCH(int, elapsed);
+    QFETCH(int, nextTaps);
+    QFETCH(int, firedTaps);
+
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 1);
+
+    QCOMPARE(machine.next(TapStateMachine::TAP, FINGERS, time + elapsed), TapStateMachine::NONE);
+    QCOMPARE(machine.getNumTaps(), nextTaps);
+    QCOMPARE(machine.getFiredTaps(), firedTaps);
+}
+
+void TapStateMachineTest::clockChange()
+{
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 2);
+
+    machine.next(TapStateMachine::TAP, FINGERS, time - 1);
+    QCOMPARE(machine.getNumTaps(), 1);
+    QCOMPARE(machine.getFiredTaps(), 2);
+}
+
+void TapStateMachineTest::fingerMismatch()
+{
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 1);
+
+    // The tap of FINGERS is fired and the sequence continues with OTHER_FINGERS
+    time += INTERVAL;
+    machine.next(TapStateMachine::TAP, OTHER_FINGERS, time);
+    QCOMPARE(machine.getNumTaps(), 1);
+    QCOMPARE(machine.getFiredTaps(), 1);
+
+    time += INTERVAL;
+    machine.next(TapStateMachine::TAP, OTHER_FINGERS, time);
+    QCOMPARE(machine.getNumTaps(), 2);
+    QCOMPARE(machine.getFiredTaps(), 0);
+
+    // A drag with the fingers of the first sequence is not a TAP_AND_HOLD of the new one
+    time += INTERVAL;
+    QCOMPARE(machine.next(TapStateMachine::DRAG, FINGERS, time), TapStateMachine::NONE);
+    QCOMPARE(machine.getNumTaps(), 0);
+    QCOMPARE(machine.getFiredTaps(), 2);
+}
+
+void TapStateMachineTest::tapAndHold()
+{
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 1);
+
+    // The pending tap is consumed by the TAP_AND_HOLD
+    QCOMPARE(machine.next(TapStateMachine::DRAG, FINGERS, time + TIME), TapStateMachine::HOLD);
+    QCOMPARE(machine.getNumTaps(), 0);
+    QCOMPARE(machine.getFiredTaps(), 0);
+
+    // A late drag fires the tap and runs as a normal drag
+    time = TapStateMachineTest::prepare(&machine, 1);
+    QCOMPARE(machine.next(TapStateMachine::DRAG, FINGERS, time + TIME + 1), TapStateMachine::NONE);
+    QCOMPARE(machine.getNumTaps(), 0);
+    QCOMPARE(machine.getFiredTaps(), 1);
+}
+
+void TapStateMachineTest::firedTapsReset()
+{
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 1);
+
+    machine.next(TapStateMachine::TIMEOUT, 0, 0);
+    QCOMPARE(machine.getFiredTaps(), 1);
+
+    machine.next(TapStateMachine::TAP, FINGERS, time + INTERVAL);
+    QCOMPARE(machine.getFiredTaps(), 0);
+}
+
+void TapStateMachineTest::clear()
+{
+    TapStateMachine machine;
+    qint64 time = TapStateMachineTest::prepare(&machine, 2);
+
+    machine.clear();
+    QCOMPARE(machine.getNumTaps(), 0);
+    QCOMPARE(machine.getFiredTaps(), 0);
+
+    // The cleared taps are not fired by the next events
+    machine.next(TapStateMachine::TIMEOUT, 0, 0);
+    QCOMPARE(machine.getFiredTaps(), 0);
+
+    // The next tap starts a new sequence, even with the fingers of the cleared one
+    time += INTERVAL;
+    machine.next(TapStateMachine::TAP, FINGERS, time);
+    QCOMPARE(machine.getNumTaps(), 1);
+    QCOMPARE(machine.getFiredTaps(), 0);
+
+    // And the clear after a fired tap resets the fired taps too
+    machine.next(TapStateMachine::OTHER, FINGERS, time + INTERVAL);
+    QCOMPARE(machine.getFiredTaps(), 1);
+    machine.clear();
+    QCOMPARE(machine.getFiredTaps(), 0);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+qint64 TapStateMachineTest::prepare(TapStateMachine *machine, int numTaps)
+{
+    machine->clear();
+    machine->setTime(TIME);
+
+    qint64 time = 1000;
+    machine->next(TapStateMachine::TAP, FINGERS, time);
+    if (numTaps == 0)
+        machine->next(TapStateMachine::TIMEOUT, 0, 0);
+
+    for (int n = 1; n < numTaps; n++) {
+        time += INTERVAL;
+        machine->next(TapStateMachine::TAP, FINGERS, time);
+    }
+
+    return time;
+}
+
+QTEST_APPLESS_MAIN(TapStateMachineTest)
@@ -0,0 +1,88 @@
+/**
+ * @file /src/tests/TapStateMachineTest.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TapStateMachineTest
+ */
+#ifndef TAPSTATEMACHINETEST_H
+#define TAPSTATEMACHINETEST_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/gestures/tap/TapStateMachine.h"
+#include <QtTest>
+
+/**
+ * Unit tests of TapStateMachine. The expected transitions are written again here instead of reading the table of the
+ * machine, so a change in the table has to be made in both places.
+ */
+class TapStateMachineTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * Every cell of the table: each state, reached with taps of 2 fingers, and each input.
+     */
+    void transitions_data();
+    void transitions();
+
+    /**
+     * A tap continues the sequence when it arrives exactly at the composed gestures time, but not 1 ms later.
+     */
+    void expiry_data();
+    void expiry();
+
+    /**
+     * A timestamp older than the last tap ends the sequence.
+     */
+    void clockChange();
+
+    /**
+     * A tap with other fingers fires the pending taps and starts a new sequence with its fingers.
+     */
+    void fingerMismatch();
+
+    /**
+     * A drag with the fingers of the pending tap is the second part of a TAP_AND_HOLD, unless the time has expired.
+     */
+    void tapAndHold();
+
+    /**
+     * The fired taps are reported only by the event that fires them.
+     */
+    void firedTapsReset();
+
+    /**
+     * clear() discards the pending taps without firing them.
+     */
+    void clear();
+
+private:
+
+    /**
+     * Creates a machine and takes it to the state with the indicated pending taps, all of them of FINGERS fingers. The
+     * IDLE state is reached with a timed out tap, so it remembers the fingers of the last sequence.
+     * @param machine The machine.
+     * @param numTaps Number of pending taps.
+     * @return The timestamp of the last event.
+     */
+    static qint64 prepare(TapStateMachine *machine, int numTaps);
+
+};
+
+#endif // TAPSTATEMACHINETEST_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/tests/TapStateMachineTest.h
+
+SOURCES += \
+    src/tests/TapStateMachineTest.cpp
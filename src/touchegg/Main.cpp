@@ -18,6 +18,10 @@
  * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
  */
 #include "src/touchegg/Touchegg.h"
+#include "src/touchegg/eventloop/EpollEventDispatcher.h"
+#include "src/touchegg/launcher/CommandLauncher.h"
+#include <csignal>
+#include <cstring>
 
 /**
  * Start function for Touchégg.
@@ -26,6 +30,22 @@
  */
 int main(int argc, char **argv)
 {
+    // The commands are run from a helper process forked now, while the process is small and has only one thread
+    CommandLauncher::getInstance()->start();
+
+    // The actions use their own connection to the X server from another thread, see ActionInjector
+    XInitThreads();
+
+    // "--epoll" replaces the Qt event dispatcher, it must be created before the application. The signals are blocked
+    // here, before the ActionInjector thread is created
+    for (int n = 1; n < argc; n++) {
+        if (strcmp(argv[n], "--epoll") == 0) {
+            EpollEventDispatcher *dispatcher = new EpollEventDispatcher();
+            dispatcher->watchSignals(QList<int>() << SIGUSR1 << SIGINT << SIGTERM);
+            break;
+        }
+    }
+
     Touchegg touchegg(argc, argv);
     return touchegg.exec();
 }
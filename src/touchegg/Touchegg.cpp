@@ -19,32 +19,116 @@
  * @class  Touchegg
  */
 #include "Touchegg.h"
+#include <cerrno>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+int Touchegg::signalFd[2];
+
+void Touchegg::unixSignalHandler(int signal)
+{
+    // A full socket (EAGAIN) already has signals pending to be read, so only the interrupted writes are retried. errno
+    // is restored for the interrupted code
+    int savedErrno = errno;
+    char signalNumber = signal;
+    ssize_t ret;
+    do {
+        ret = ::write(Touchegg::signalFd[0], &signalNumber, sizeof(signalNumber));
+    } while (ret == -1 && errno == EINTR);
+    errno = savedErrno;
+}
 
 // ****************************************************************************************************************** //
 // **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
 // ****************************************************************************************************************** //
 
 Touchegg::Touchegg(int &argc, char **argv)
-    : QApplication(argc, argv),
+    : QCoreApplication(argc, argv),
       windowListener(new WindowListener(this)),
-      gestureCollector(new GestureCollector(this)),
+      gestureCollector(NULL),
+      traceReplayer(NULL),
       gestureHandler(new GestureHandler(this))
 {
-    qDebug() << "Try to make a multitouch gesture. If everything goes well the "
-            "information about the gesture must appear";
+    QStringList args = this->arguments();
 
-    connect(this->gestureCollector, SIGNAL(ready()), this, SLOT(start()));
-}
+    // "--stats" enables the latency instrumentation, printed on SIGUSR1 and at exit
+    if (args.contains("--stats"))
+        LatencyStats::enable();
 
+    // The WindowListener receives the notifications of creation/destruction of windows
+    XConnection::getInstance()->listen();
+    connect(XConnection::getInstance(), SIGNAL(eventReceived(XEvent*)),
+            this->windowListener, SLOT(x11Event(XEvent*)));
 
-// ****************************************************************************************************************** //
-// **********                                       PROTECTED METHODS                                      ********** //
-// ****************************************************************************************************************** //
+    // The RootWindowCache mirrors the stacking list, used to know the window of each gesture
+    connect(XConnection::getInstance(), SIGNAL(eventReceived(XEvent*)),
+            RootWindowCache::getInstance(), SLOT(x11Event(XEvent*)));
+
+    // The MonitorCache mirrors the geometry of the monitors, used by the actions that depend on it
+    connect(XConnection::getInstance(), SIGNAL(eventReceived(XEvent*)),
+            MonitorCache::getInstance(), SLOT(x11Event(XEvent*)));
+
+    // The actions are executed in their own thread and connection to the X server
+    ActionInjector::getInstance()->startInjector();
+
+    // "--replay <file> [--replay-speed <speed>]" plays back a trace instead of collecting the gestures with uTouch
+    int replayArg = args.indexOf("--replay");
+    if (replayArg != -1 && replayArg + 1 < args.length()) {
+        double speed = 1;
+        int speedArg = args.indexOf("--replay-speed");
+        if (speedArg != -1 && speedArg + 1 < args.length())
+            speed = qMax(0.0, args.at(speedArg + 1).toDouble());
 
-bool Touchegg::x11EventFilter(XEvent *event)
+        this->traceReplayer = new TraceReplayer(args.at(replayArg + 1), speed, this);
+        this->connectGestureSource(this->traceReplayer);
+        connect(this->traceReplayer, SIGNAL(finished()), this, SLOT(quit()));
+        QTimer::singleShot(0, this->traceReplayer, SLOT(start()));
+
+    } else {
+        qDebug() << "Try to make a multitouch gesture. If everything goes well the "
+                "information about the gesture must appear";
+
+        this->gestureCollector = new GestureCollector(this);
+        connect(this->gestureCollector, SIGNAL(ready()), this, SLOT(start()));
+
+        // "--record <file>" saves the collected gestures in a trace that can be played back with "--replay"
+        int recordArg = args.indexOf("--record");
+        if (recordArg != -1 && recordArg + 1 < args.length())
+            this->gestureCollector->startRecording(args.at(recordArg + 1));
+    }
+
+    // With the epoll event dispatcher the signals are received through its signalfd, see Main.cpp
+    EpollEventDispatcher *dispatcher = qobject_cast<EpollEventDispatcher *>(QAbstractEventDispatcher::instance());
+    if (dispatcher != NULL && dispatcher->isWatchingSignals()) {
+        this->signalNotifier = NULL;
+        connect(dispatcher, SIGNAL(unixSignal(int)), this, SLOT(handleSignal(int)));
+
+    } else {
+        // Non-blocking, so the signal handler never blocks when the socket is full
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, Touchegg::signalFd) != 0)
+            qFatal("Couldn't create the signals socket pair");
+        this->signalNotifier = new QSocketNotifier(Touchegg::signalFd[1], QSocketNotifier::Read, this);
+        connect(this->signalNotifier, SIGNAL(activated(int)), this, SLOT(readSignal()));
+
+        struct sigaction action;
+        action.sa_handler = Touchegg::unixSignalHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &action, NULL);
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+    }
+}
+
+Touchegg::~Touchegg()
 {
-    this->windowListener->x11Event(event);
-    return false;
+    ActionInjector::getInstance()->stopInjector();
+    LatencyStats::dump();
 }
 
 
@@ -62,24 +146,49 @@ void Touchegg::start()
 
     // The GestureCollector collect the gestures and the GestureHandler perform its and add a layer to perform
     // composed gestures
-    connect(gestureCollector, SIGNAL(executeGestureStart(
+    this->connectGestureSource(this->gestureCollector);
+
+    // Subscribe to global gestures
+    this->gestureCollector->addWindow(XConnection::rootWindow());
+
+    // Subscribe to application specific gestures
+    foreach(Window w, this->windowListener->getClientList()) {
+        this->gestureCollector->addWindow(w);
+    }
+}
+
+void Touchegg::readSignal()
+{
+    char signalNumber;
+    if (::read(Touchegg::signalFd[1], &signalNumber, sizeof(signalNumber)) == sizeof(signalNumber))
+        this->handleSignal(signalNumber);
+}
+
+void Touchegg::handleSignal(int signalNumber)
+{
+    if (signalNumber == SIGUSR1)
+        LatencyStats::dump();
+    else
+        this->quit();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void Touchegg::connectGestureSource(QObject *source)
+{
+    connect(source, SIGNAL(executeGestureStart(
             QString, int, QHash<QString, QVariant>)),
             gestureHandler, SLOT(executeGestureStart(
                     QString, int, QHash<QString, QVariant>)));
-    connect(gestureCollector, SIGNAL(executeGestureUpdate(
+    connect(source, SIGNAL(executeGestureUpdate(
             QString, int, QHash<QString, QVariant>)),
             gestureHandler, SLOT(executeGestureUpdate(
                     QString, int, QHash<QString, QVariant>)));
-    connect(gestureCollector, SIGNAL(executeGestureFinish(
+    connect(source, SIGNAL(executeGestureFinish(
             QString, int, QHash<QString, QVariant>)),
             gestureHandler, SLOT(executeGestureFinish(
                     QString, int, QHash<QString, QVariant>)));
-
-    // Subscribe to global gestures
-    this->gestureCollector->addWindow(QX11Info::appRootWindow());
-
-    // Subscribe to application specific gestures
-    foreach(Window w, this->windowListener->getClientList()) {
-        this->gestureCollector->addWindow(w);
-    }
 }
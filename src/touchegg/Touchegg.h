@@ -22,9 +22,16 @@
 #define TOUCHEGG_H
 
 #include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XConnection.h"
+#include "src/touchegg/eventloop/EpollEventDispatcher.h"
 #include "src/touchegg/windows/WindowListener.h"
+#include "src/touchegg/windows/RootWindowCache.h"
+#include "src/touchegg/monitors/MonitorCache.h"
 #include "src/touchegg/gestures/collector/GestureCollector.h"
 #include "src/touchegg/gestures/handler/GestureHandler.h"
+#include "src/touchegg/gestures/trace/TraceReplayer.h"
+#include "src/touchegg/actions/injector/ActionInjector.h"
+#include "src/touchegg/stats/LatencyStats.h"
 
 /**
  * Initializes and launches Touchégg. To do this uses these three classes:
@@ -33,7 +40,7 @@
  * - GestureCollector: To get the multitouch events in the windows selected by the WindowListener.
  * - GestureHandler: To treat the multitouch events collected by the GestureCollector.
  */
-class Touchegg : public QApplication
+class Touchegg : public QCoreApplication
 {
     Q_OBJECT
 
@@ -44,16 +51,10 @@ public:
      */
     Touchegg(int &argc, char **argv);
 
-protected:
-
     /**
-     * Reimplement the method QApplication::x11EventFilter. This method receives the notifications of
-     * creation/destruction of windows and manage it as appropriate using WindowListener.
-     * @param  event The event that occurred.
-     * @return true if you want to stop the event from being processed, ie when we treat ourselves, false for normal
-     *         event dispatching.
+     * Destructor. Prints the latency statistics if they are enabled.
      */
-    virtual bool x11EventFilter(XEvent *event);
+    virtual ~Touchegg();
 
 private slots:
 
@@ -62,11 +63,44 @@ private slots:
      */
     void start();
 
+    /**
+     * Reads a Unix signal number written in signalFd by unixSignalHandler() and handles it.
+     */
+    void readSignal();
+
+    /**
+     * Called when a Unix signal is received. SIGUSR1 prints the latency statistics, SIGINT and SIGTERM quit.
+     * @param signalNumber The signal number.
+     */
+    void handleSignal(int signalNumber);
+
 private:
 
+    /**
+     * Unix signal handler. Only writes the signal number in signalFd, where readSignal() reads it.
+     * @param signal The signal number.
+     */
+    static void unixSignalHandler(int signal);
+
+    /**
+     * Connects the signals of a GestureCollector or a TraceReplayer with the GestureHandler.
+     * @param source The GestureCollector or the TraceReplayer.
+     */
+    void connectGestureSource(QObject *source);
+
+    /**
+     * Socket pair used to handle the Unix signals from the Qt event loop.
+     */
+    static int signalFd[2];
+
+    /**
+     * Notifier of the signals written in signalFd, NULL if the signals are received through the EpollEventDispatcher.
+     */
+    QSocketNotifier *signalNotifier;
+
     /**
      * Class to get the creation and destruction of windows.
-     * @see x11EventFilter()
+     * @see XConnection
      * @see WindowListener
      */
     WindowListener *windowListener;
@@ -77,6 +111,12 @@ private:
      */
     GestureCollector *gestureCollector;
 
+    /**
+     * Class to play back a trace of gestures instead of collecting them, NULL if not replaying.
+     * @see TraceReplayer
+     */
+    TraceReplayer *traceReplayer;
+
     /**
      * Class to treat the gestures and execute the corresponding action.
      * @see GestureHandler
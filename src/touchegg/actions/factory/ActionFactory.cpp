@@ -88,6 +88,12 @@ Action *ActionFactory::createAction(ActionTypeEnum::ActionType actionType,
     case ActionTypeEnum::DRAG_AND_DROP:
         return new DragAndDrop(settings, window);
 
+    case ActionTypeEnum::ZOOM:
+        return new Zoom(settings, window);
+
+    case ActionTypeEnum::ROTATE:
+        return new Rotate(settings, window);
+
     default:
         return NULL;
     }
@@ -39,6 +39,8 @@
 #include "src/touchegg/actions/implementation/MoveWindow.h"
 #include "src/touchegg/actions/implementation/RunCommand.h"
 #include "src/touchegg/actions/implementation/DragAndDrop.h"
+#include "src/touchegg/actions/implementation/Zoom.h"
+#include "src/touchegg/actions/implementation/Rotate.h"
 
 /**
  * Factory to create the different actions.
@@ -0,0 +1,180 @@
+/**
+ * @file /src/touchegg/actions/implementation/Action.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Action
+ */
+#include "Action.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+Action::Action(const QString &settings, Window window)
+    : settings(settings),
+      at_start(false),
+      at_update(false),
+      window(window),
+      step(0),
+      rate(0),
+      gain(1),
+      pixelsPerMm(MonitorCache::getInstance()->getPixelsPerMm(NULL)),
+      pixelsX(0),
+      pixelsY(0),
+      displacement(0),
+      tokens(1),
+      lastTimestamp(-1)
+{
+    this->clock.start();
+}
+
+Action::Action(const QString &settings, const QString &timing, Window window)
+    : settings(settings),
+      at_start(timing == "AT_START"),
+      at_update(timing == "AT_UPDATE"),
+      window(window),
+      step(0),
+      rate(0),
+      gain(1),
+      pixelsPerMm(MonitorCache::getInstance()->getPixelsPerMm(NULL)),
+      pixelsX(0),
+      pixelsY(0),
+      displacement(0),
+      tokens(1),
+      lastTimestamp(-1)
+{
+    this->clock.start();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void Action::executeCancel() {}
+
+bool Action::canRunSpeculatively() const
+{
+    return false;
+}
+
+void Action::setUpdateStep(float step, float rate)
+{
+    this->step = step;
+    this->rate = rate;
+}
+
+void Action::setGain(float gain)
+{
+    this->gain = gain;
+}
+
+void Action::setMonitor(const MonitorInfo *monitor)
+{
+    // The same density used by DeviceTable::normalizeDeltas(), so the pixels of a touchscreen are restored exactly
+    this->pixelsPerMm = MonitorCache::getInstance()->getPixelsPerMm(monitor);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                       PROTECTED METHODS                                      ********** //
+// ****************************************************************************************************************** //
+
+bool Action::isUpdateStep(const QHash<QString, QVariant>& attrs)
+{
+    if (!this->at_update)
+        return false;
+
+    // Displacement of the update in the units of the gesture
+    if (attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_X) || attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_Y)) {
+        float deltaX = this->getDeltaX(attrs);
+        float deltaY = this->getDeltaY(attrs);
+        this->displacement += std::sqrt(deltaX * deltaX + deltaY * deltaY);
+    } else if (attrs.contains(GEIS_GESTURE_ATTRIBUTE_ANGLE_DELTA)) {
+        this->displacement += std::fabs(attrs.value(GEIS_GESTURE_ATTRIBUTE_ANGLE_DELTA).toFloat()) * 180 / M_PI;
+    } else if (attrs.contains(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA)) {
+        this->displacement += std::fabs(attrs.value(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA).toFloat() - 1) * 100;
+    }
+
+    this->refillTokens(attrs, this->rate);
+
+    if (this->displacement < this->step || this->displacement == 0)
+        return false;
+
+    this->displacement = (this->step > 0) ? std::fmod(this->displacement, this->step) : 0;
+
+    return this->takeToken(this->rate);
+}
+
+void Action::refillTokens(const QHash<QString, QVariant>& attrs, float rate)
+{
+    qint64 timestamp = attrs.contains(GEIS_GESTURE_ATTRIBUTE_TIMESTAMP)
+            ? attrs.value(GEIS_GESTURE_ATTRIBUTE_TIMESTAMP).toLongLong()
+            : this->clock.elapsed();
+    if (this->lastTimestamp >= 0 && rate > 0)
+        this->tokens = qMin(1.0f, this->tokens + (timestamp - this->lastTimestamp) * rate / 1000);
+    this->lastTimestamp = timestamp;
+}
+
+bool Action::takeToken(float rate)
+{
+    if (rate <= 0)
+        return true;
+    if (this->tokens < 1)
+        return false;
+
+    this->tokens -= 1;
+    return true;
+}
+
+KeyCode Action::getKeyCode(const QString &key)
+{
+    QString keyName = key.trimmed();
+    if (keyName == "Control" || keyName == "Shift" || keyName == "Super" || keyName == "Alt")
+        keyName.append("_L");
+    else if (keyName == "AltGr")
+        keyName = "Alt_R";
+
+    KeySym keySym = XStringToKeysym(keyName.toStdString().c_str());
+    return XKeysymToKeycode(XConnection::display(), keySym);
+}
+
+float Action::getDeltaX(const QHash<QString, QVariant>& attrs) const
+{
+    return attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat() * this->gain;
+}
+
+float Action::getDeltaY(const QHash<QString, QVariant>& attrs) const
+{
+    return attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat() * this->gain;
+}
+
+int Action::getPixelsX(const QHash<QString, QVariant>& attrs)
+{
+    this->pixelsX += this->getDeltaX(attrs) * this->pixelsPerMm;
+    int ret = (int)this->pixelsX;
+    this->pixelsX -= ret;
+    return ret;
+}
+
+int Action::getPixelsY(const QHash<QString, QVariant>& attrs)
+{
+    this->pixelsY += this->getDeltaY(attrs) * this->pixelsPerMm;
+    int ret = (int)this->pixelsY;
+    this->pixelsY -= ret;
+    return ret;
+}
@@ -22,6 +22,11 @@
 #define ACTION_H
 
 #include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XConnection.h"
+#include "src/touchegg/x11/XCalls.h"
+#include "src/touchegg/x11/XcbCalls.h"
+#include "src/touchegg/actions/injector/ActionInjector.h"
+#include "src/touchegg/monitors/MonitorCache.h"
 
 /**
  * Class that should inherit all actions. Actions are operations associated with
@@ -37,12 +42,7 @@ public:
      * @param settings Gesture settings.
      * @param window   Window on which execute the action.
      */
-    Action(const QString &settings, Window window)
-        : settings(settings),
-          window(window) {
-
-        at_start = false;
-    }
+    Action(const QString &settings, Window window);
 
     virtual ~Action() {}
 
@@ -52,16 +52,28 @@ public:
      * @param timing Timing information.
      * @param window Window on which to execute the action
      */
-    Action(const QString &settings, const QString &timing, Window window)
-        : settings(settings),
-          window(window) {
+    Action(const QString &settings, const QString &timing, Window window);
+
+    /**
+     * Sets the step and the rate of the AT_UPDATE timing.
+     * @param step Displacement between two executions: millimetres for the drags, degrees for the rotations and
+     *        percentage of the initial size for the pinches.
+     * @param rate Maximum number of executions per second, 0 for no limit.
+     */
+    void setUpdateStep(float step, float rate);
+
+    /**
+     * Sets the factor applied to the displacement of the drags, that depends on the touch device.
+     * @param gain The gain.
+     */
+    void setGain(float gain);
 
-        if (timing == "AT_START") {
-            at_start = true;
-        } else {
-            at_start = false;
-        }
-    }
+    /**
+     * Sets the monitor where the gesture is made, whose pixel density converts the millimetres of the gesture to
+     * pixels.
+     * @param monitor The monitor or NULL if unknown.
+     */
+    void setMonitor(const MonitorInfo *monitor);
 
     /**
      * Part of the action that will be executed when the gesture is started.
@@ -84,23 +96,131 @@ public:
      */
     virtual void executeFinish(const QHash<QString, QVariant>& attrs) = 0;
 
+    /**
+     * Executed instead of executeFinish() when the gesture is cancelled because it never finished. Must release the
+     * keys and buttons that the action keeps pressed. By default does nothing.
+     */
+    virtual void executeCancel();
+
+    /**
+     * Returns if the action is harmless when the tap that executes it turns out to be the start of a composed gesture,
+     * so it can be executed speculatively before the next tap. Only the actions that don't destroy or hide the window
+     * of the gesture, where the composed gesture runs, and can be undone may return true. By default false.
+     * @return If the action can be executed speculatively.
+     */
+    virtual bool canRunSpeculatively() const;
+
 protected:
 
+    /**
+     * With the AT_UPDATE timing, accumulates the displacement of an update and returns if the action has to be
+     * executed: the displacement has crossed the step and the token bucket that limits the rate has a token. The steps
+     * crossed without tokens are discarded, so a long gesture never queues executions.
+     * @param  attrs Gesture attributes of the update.
+     * @return If the action has to be executed.
+     */
+    bool isUpdateStep(const QHash<QString, QVariant>& attrs);
+
+    /**
+     * Refills the token bucket that limits the rate of executions with the time elapsed since the previous update.
+     * @param attrs Gesture attributes of the update.
+     * @param rate  Maximum number of executions per second, 0 for no limit.
+     */
+    void refillTokens(const QHash<QString, QVariant>& attrs, float rate);
+
+    /**
+     * Takes a token of the bucket, if the rate is limited.
+     * @param  rate Maximum number of executions per second, 0 for no limit.
+     * @return If the execution is allowed.
+     */
+    bool takeToken(float rate);
+
+    /**
+     * Returns the keycode of a key of the configuration. The modifiers "Control", "Shift", "Super" and "Alt" are the
+     * left ones and "AltGr" is the right Alt. Uses the X connection of the main thread, so it must be called from the
+     * constructors and not from the execute methods, that run in the injection thread.
+     * @param  key The name of the key, as in SEND_KEYS.
+     * @return The keycode, 0 if the key doesn't exist.
+     */
+    static KeyCode getKeyCode(const QString &key);
+
+    /**
+     * Returns the displacement of an update in the X and Y axes, in millimetres and with the gain of the device
+     * applied.
+     * @param  attrs Gesture attributes of the update.
+     * @return The displacement, 0 if the update doesn't have it.
+     */
+    float getDeltaX(const QHash<QString, QVariant>& attrs) const;
+    float getDeltaY(const QHash<QString, QVariant>& attrs) const;
+
+    /**
+     * Returns the displacement of an update in screen pixels, to move the pointer as much as the fingers, with the
+     * pixel density of the monitor of the gesture or of the X screen if unknown. The fractions of pixel are accumulated
+     * for the next updates.
+     * @param  attrs Gesture attributes of the update.
+     * @return The displacement in pixels.
+     */
+    int getPixelsX(const QHash<QString, QVariant>& attrs);
+    int getPixelsY(const QHash<QString, QVariant>& attrs);
+
+    //------------------------------------------------------------------------------------------------------------------
+
     /**
      * Action settings.
      */
     QString settings;
 
     /**
-     * Timing information (only applies to certain actions).
+     * Timing information (only applies to certain actions). If none of them is set the action is executed at the end.
      */
     bool at_start;
+    bool at_update;
 
     /**
      * Window on which execute the action.
      */
     Window window;
 
+private:
+
+    /**
+     * AT_UPDATE step and rate.
+     */
+    float step;
+    float rate;
+
+    /**
+     * Gain of the displacement of the drags.
+     */
+    float gain;
+
+    /**
+     * Pixels per millimetre used by getPixelsX() and getPixelsY().
+     */
+    float pixelsPerMm;
+
+    /**
+     * Fractions of pixel not returned yet by getPixelsX() and getPixelsY().
+     */
+    float pixelsX;
+    float pixelsY;
+
+    /**
+     * Displacement accumulated since the last step.
+     */
+    float displacement;
+
+    /**
+     * Token bucket: available tokens (at most 1) and timestamp, in milliseconds, of the last update.
+     */
+    float tokens;
+    qint64 lastTimestamp;
+
+    /**
+     * Clock used when the updates don't have timestamp.
+     */
+    QElapsedTimer clock;
+
 };
 
 #endif // ACTION_H
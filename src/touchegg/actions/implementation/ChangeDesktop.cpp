@@ -25,16 +25,52 @@
 // ****************************************************************************************************************** //
 
 ChangeDesktop::ChangeDesktop(const QString &settings, const QString &timing, Window window)
-    : Action(settings, timing, window)
+    : Action(settings, timing, window),
+      next(true),
+      continuous(false),
+      axisX(true),
+      distance(30),
+      position(0)
 {
-    this->next = true;
+    // Read in the main thread, the action is executed in the injection thread
+    this->numDesktops    = RootWindowCache::getInstance()->getNumDesktops();
+    this->startDesktop   = RootWindowCache::getInstance()->getCurrentDesktop();
+    this->currentDesktop = this->startDesktop;
 
-    if (settings == "PREVIOUS")
+    bool error = false;
+    QStringList mainStr = settings.split(":");
+
+    if (mainStr.first() == "PREVIOUS" && mainStr.length() == 1) {
         this->next = false;
-    else if (settings == "NEXT")
+    } else if (mainStr.first() == "NEXT" && mainStr.length() == 1) {
         this->next = true;
-    else
-        qWarning() << "Error reading CHANGE_VIEWPORT settings, using the default settings";
+    } else if (mainStr.first() == "CONTINUOUS") {
+        this->continuous = true;
+
+        for (int n = 1; n < mainStr.length(); n++) {
+            QStringList settingPair = mainStr.at(n).split("=");
+            if (settingPair.length() != 2) {
+                error = true;
+                continue;
+            }
+
+            if (settingPair.at(0) == "AXIS" && (settingPair.at(1) == "X" || settingPair.at(1) == "Y")) {
+                this->axisX = (settingPair.at(1) == "X");
+            } else if (settingPair.at(0) == "DISTANCE" && settingPair.at(1).toFloat() > 0) {
+                this->distance = settingPair.at(1).toFloat();
+            } else if (settingPair.at(0) == "INVERTED"
+                    && (settingPair.at(1) == "true" || settingPair.at(1) == "false")) {
+                this->next = (settingPair.at(1) == "false");
+            } else {
+                error = true;
+            }
+        }
+    } else {
+        error = true;
+    }
+
+    if (error)
+        qWarning() << "Error reading CHANGE_DESKTOP settings, using the default settings";
 }
 
 
@@ -44,53 +80,55 @@ ChangeDesktop::ChangeDesktop(const QString &settings, const QString &timing, Win
 
 void ChangeDesktop::executeStart(const QHash<QString, QVariant>& /*attrs*/)
 {
-    if (at_start) {
+    if (at_start && !this->continuous) {
         changeDesktop();
     }
 }
 
-void ChangeDesktop::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void ChangeDesktop::executeUpdate(const QHash<QString, QVariant>& attrs)
+{
+    if (!this->continuous) {
+        if (isUpdateStep(attrs)) {
+            changeDesktop();
+        }
+        return;
+    }
+
+    if (this->numDesktops == 0)
+        return;
+
+    float delta = this->axisX ? this->getDeltaX(attrs) : this->getDeltaY(attrs);
+    this->position += (this->next ? delta : -delta) / this->distance;
+
+    // The position doesn't go beyond the first and last desktops, so going back from them switches desktop at once.
+    // Rounded, so going back half a desktop undoes a switch
+    this->position = qBound((float)-this->startDesktop, this->position,
+            (float)(this->numDesktops - 1 - this->startDesktop));
+    this->switchTo(this->startDesktop + qRound(this->position));
+}
 
 void ChangeDesktop::executeFinish(const QHash<QString, QVariant>& /*attrs*/)
 {
-    if (!at_start) {
+    if (!at_start && !at_update && !this->continuous) {
         changeDesktop();
     }
 }
 
 void ChangeDesktop::changeDesktop() {
-    // Get the number of desktops
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
-
-    XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(),
-            XInternAtom(QX11Info::display(), "_NET_NUMBER_OF_DESKTOPS", false),
-            0, 1, false, XA_CARDINAL, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet);
-    int numDesktops = (int) * propRet;
-    XFree(propRet);
-
-    // Get the current desktop
-    XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(),
-            XInternAtom(QX11Info::display(), "_NET_CURRENT_DESKTOP", false),
-            0, 1, false, XA_CARDINAL, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet);
-    int currentDesktop = (int) * propRet;
-    XFree(propRet);
+    if (this->numDesktops == 0)
+        return;
 
     // Switch to the next/previous desktop
-    int nextDesktop = this->next
-            ? (currentDesktop + 1) % numDesktops
-            : (currentDesktop - 1 + numDesktops) % numDesktops;
-
-    XClientMessageEvent event;
-    event.window = QX11Info::appRootWindow(QX11Info::appScreen());
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_CURRENT_DESKTOP", false);
-    event.format = 32;
-    event.data.l[0] = nextDesktop;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
+    this->switchTo(this->next
+            ? (this->currentDesktop + 1) % this->numDesktops
+            : (this->currentDesktop - 1 + this->numDesktops) % this->numDesktops);
+}
+
+void ChangeDesktop::switchTo(int desktop)
+{
+    if (desktop == this->currentDesktop)
+        return;
+
+    this->currentDesktop = desktop;
+    XcbCalls::sendClientMessage(ActionInjector::display(), XConnection::rootWindow(), "_NET_CURRENT_DESKTOP", desktop);
 }
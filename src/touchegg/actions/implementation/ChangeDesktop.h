@@ -23,9 +23,18 @@
 
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/actions/implementation/Action.h"
+#include "src/touchegg/windows/RootWindowCache.h"
 
 /**
  * Change the desktop.
+ *
+ * With the settings "NEXT" or "PREVIOUS" switches one desktop each time the action is executed. With "CONTINUOUS" the
+ * desktop follows the drag: each DISTANCE millimetres along the AXIS (X or Y) switch to the next desktop, or to the
+ * previous one if the drag goes backwards or INVERTED is true, without wrapping around. For example,
+ * "CONTINUOUS:AXIS=X:DISTANCE=30:INVERTED=false".
+ *
+ * The desktops are read from the RootWindowCache when the action is created, so executing it doesn't wait for any
+ * reply of the X server.
  */
 class ChangeDesktop : public Action
 {
@@ -41,16 +50,42 @@ public:
     void executeFinish(const QHash<QString, QVariant>& attrs);
 
 protected:
+
     /**
      * Helper method that actually does the switching
      */
     void changeDesktop();
 
+    /**
+     * Switches to a desktop, if it is not the current one.
+     * @param desktop Index of the desktop.
+     */
+    void switchTo(int desktop);
+
     /**
      * Direction to switch desktops.
      */
     bool next;
 
+    /**
+     * If the desktop follows the drag.
+     */
+    bool continuous;
+
+    /**
+     * With "CONTINUOUS", if the drag is along the X axis, millimetres to switch a desktop and displacement along the
+     * axis since the gesture started, in desktops (negative to the previous ones).
+     */
+    bool axisX;
+    float distance;
+    float position;
+
+    /**
+     * Number of desktops, desktop when the action was created and desktop switched to by the action.
+     */
+    int numDesktops;
+    int startDesktop;
+    int currentDesktop;
 
 };
 
@@ -27,6 +27,11 @@
 ChangeViewport::ChangeViewport(const QString &settings, const QString &timing, Window window)
     : Action(settings, timing, window)
 {
+    // Read in the main thread, the action is executed in the injection thread
+    this->desktopGeometry = RootWindowCache::getInstance()->getDesktopGeometry();
+    this->viewport        = RootWindowCache::getInstance()->getDesktopViewport();
+    this->viewportSize    = MonitorCache::getInstance()->getScreenGeometry().size();
+
     this->next = true;
 
     if (settings == "PREVIOUS")
@@ -48,79 +53,40 @@ void ChangeViewport::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void ChangeViewport::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void ChangeViewport::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        changeViewport();
+    }
+}
 
 void ChangeViewport::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         changeViewport();
     }
 }
 
 void ChangeViewport::changeViewport() {
-    // Get the size of all viewports together
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
+    if (this->desktopGeometry.isEmpty() || this->viewportSize.isEmpty())
+        return;
 
-    int widthViews, heightViews;
-    if (XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(),
-            XInternAtom(QX11Info::display(), "_NET_DESKTOP_GEOMETRY", false),
-            0, 100, false, XA_CARDINAL, &atomRet, &size, &numItems,
-            &bytesAfterReturn, &propRet) == Success && numItems == 2) {
-        int *aux = (int *)propRet;
-        widthViews  = aux[0];
-        heightViews = aux[1];
-        XFree(propRet);
+    // Grid of viewports and index of the current one
+    int columns = qMax(1, this->desktopGeometry.width() / this->viewportSize.width());
+    int rows    = qMax(1, this->desktopGeometry.height() / this->viewportSize.height());
+    int numViewports = columns * rows;
 
-        if (widthViews == 0 || heightViews == 0)
-            return;
-    } else {
-        return;
-    }
+    int column = qBound(0, this->viewport.x() / this->viewportSize.width(), columns - 1);
+    int row    = qBound(0, this->viewport.y() / this->viewportSize.height(), rows - 1);
+    int index  = row * columns + column;
 
-    // Get the coordinates of the current viewport
-    int currentX, currentY;
-    if (XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(),
-            XInternAtom(QX11Info::display(), "_NET_DESKTOP_VIEWPORT", false),
-            0, 100, false, XA_CARDINAL, &atomRet, &size, &numItems,
-            &bytesAfterReturn, &propRet) == Success && numItems == 2) {
-        int *aux = (int *)propRet;
-        currentX = aux[0];
-        currentY = aux[1];
-        XFree(propRet);
-    } else {
-        return;
-    }
+    // Index of the next/previous viewport, wrapping around in both directions
+    index = this->next
+            ? (index + 1) % numViewports
+            : (index - 1 + numViewports) % numViewports;
 
-    // Get the coordinates of the next/previous viewport
-    int nextX, nextY;
-    if (this->next) {
-        nextX = (currentX + QApplication::desktop()->width()) % widthViews;
-        nextY = (nextX == 0)
-                ? (currentY + QApplication::desktop()->height()) % heightViews
-                : currentY;
-    } else {
-        nextX = (currentX - QApplication::desktop()->width()) % widthViews;
-        if (nextX < 0) {
-            nextY  = (currentY - QApplication::desktop()->height()) % heightViews;
-            nextX *= -1;
-            nextY *= -1;
-        } else {
-            nextY = currentY;
-        }
-    }
+    this->viewport = QPoint((index % columns) * this->viewportSize.width(),
+            (index / columns) * this->viewportSize.height());
 
     // Change the viewport
-    XClientMessageEvent event;
-    event.window = QX11Info::appRootWindow(QX11Info::appScreen());
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_DESKTOP_VIEWPORT", false);
-    event.format = 32;
-    event.data.l[0] = nextX;
-    event.data.l[1] = nextY;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
+    XcbCalls::sendClientMessage(ActionInjector::display(), XConnection::rootWindow(), "_NET_DESKTOP_VIEWPORT",
+            this->viewport.x(), this->viewport.y());
 }
@@ -16,16 +16,22 @@
  * Touchégg. If not, see <http://www.gnu.org/licenses/>.
  *
  * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
- * @class  ChangeDesktop
+ * @class  ChangeViewport
  */
 #ifndef CHANGEVIEWPORT_H
 #define CHANGEVIEWPORT_H
 
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/actions/implementation/Action.h"
+#include "src/touchegg/windows/RootWindowCache.h"
+#include "src/touchegg/monitors/MonitorCache.h"
 
 /**
- * Change the viewport.
+ * Change the viewport. The viewports are a grid of screens, traversed from left to right and from top to bottom,
+ * wrapping around at the ends.
+ *
+ * The viewports and the size of the screen are read from the RootWindowCache and the MonitorCache when the action is
+ * created, so executing it doesn't wait for any reply of the X server.
  */
 class ChangeViewport : public Action
 {
@@ -52,6 +58,13 @@ protected:
      */
     bool next;
 
+    /**
+     * Size of all viewports together, size of a viewport and top left corner of the current viewport.
+     */
+    QSize desktopGeometry;
+    QSize viewportSize;
+    QPoint viewport;
+
 };
 
 #endif // CHANGEVIEWPORT_H
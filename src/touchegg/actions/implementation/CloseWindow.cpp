@@ -38,10 +38,14 @@ void CloseWindow::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void CloseWindow::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void CloseWindow::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        closeWindow();
+    }
+}
 
 void CloseWindow::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         closeWindow();
     }
 }
@@ -51,16 +55,5 @@ void CloseWindow::closeWindow() {
         return;
 
     // Close the window
-    XClientMessageEvent event;
-    event.window = this->window;
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_CLOSE_WINDOW", false);
-    event.format = 32;
-    event.data.l[0] = CurrentTime;
-    event.data.l[1] = 2;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-
-    XFlush(QX11Info::display());
+    XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "_NET_CLOSE_WINDOW", XCB_CURRENT_TIME, 2);
 }
@@ -50,7 +50,7 @@ DragAndDrop::DragAndDrop(const QString &settings, Window window)
 
 void DragAndDrop::executeStart(const QHash<QString, QVariant>& /*attrs*/)
 {
-    XTestFakeButtonEvent(QX11Info::display(), this->button, true, 0);
+    XCalls::testFakeButtonEvent(ActionInjector::display(), this->button, true, 0);
 }
 
 void DragAndDrop::executeUpdate(const QHash<QString, QVariant>& attrs)
@@ -58,11 +58,19 @@ void DragAndDrop::executeUpdate(const QHash<QString, QVariant>& attrs)
     if (!attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_X) || !attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_Y))
         return;
 
-    QCursor::setPos(QCursor::pos().x() + attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat(),
-            QCursor::pos().y() + attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat());
+    // QCursor can only be used from the main thread
+    XCalls::testFakeRelativeMotionEvent(ActionInjector::display(),
+            this->getPixelsX(attrs), this->getPixelsY(attrs), 0);
+    XCalls::flush(ActionInjector::display());
 }
 
 void DragAndDrop::executeFinish(const QHash<QString, QVariant>& /*attrs*/)
 {
-    XTestFakeButtonEvent(QX11Info::display(), this->button, false, 0);
+    XCalls::testFakeButtonEvent(ActionInjector::display(), this->button, false, 0);
+}
+
+void DragAndDrop::executeCancel()
+{
+    XCalls::testFakeButtonEvent(ActionInjector::display(), this->button, false, 0);
+    XCalls::flush(ActionInjector::display());
 }
@@ -40,6 +40,8 @@ public:
 
     void executeFinish(const QHash<QString, QVariant>& attrs);
 
+    void executeCancel();
+
 private:
 
     /**
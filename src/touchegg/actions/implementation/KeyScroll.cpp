@@ -26,8 +26,8 @@
 
 KeyScroll::KeyScroll(const QString &settings, Window window)
     : Action(settings, window),
-      horizontalSpeed(30),
-      verticalSpeed(30),
+      horizontalSpeed(7.5),
+      verticalSpeed(7.5),
       upKeyScrollSpace(0),
       downKeyScrollSpace(0),
       leftKeyScrollSpace(0),
@@ -47,8 +47,8 @@ KeyScroll::KeyScroll(const QString &settings, Window window)
                 bool ok;
                 int configSpeed = QString(settingPair.at(1)).toInt(&ok);
                 if (ok && configSpeed >= 1 && configSpeed <= 10) {
-                    this->verticalSpeed   = 220 - 20 * configSpeed;
-                    this->horizontalSpeed = 220 - 20 * configSpeed;
+                    this->verticalSpeed   = 55 - 5 * configSpeed;
+                    this->horizontalSpeed = 55 - 5 * configSpeed;
                 } else {
                     error = true;
                 }
@@ -60,12 +60,12 @@ KeyScroll::KeyScroll(const QString &settings, Window window)
                     if (key == "Control" || key == "Shift" || key == "Super" || key == "Alt") {
                         key = key.append("_L");
                         KeySym keySym = XStringToKeysym(key.toStdString().c_str());
-                        KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                        KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                         this->holdDownKeys.append(keyCode);
 
                     } else if (key == "AltGr") {
                         KeySym keySym = XStringToKeysym("Alt_R");
-                        KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                        KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                         this->holdDownKeys.append(keyCode);
 
                     }
@@ -73,22 +73,22 @@ KeyScroll::KeyScroll(const QString &settings, Window window)
 
             } else if(settingPair.at(0) == "UP"){
                 KeySym keySym = XStringToKeysym(settingPair.at(1).toStdString().c_str());
-                KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                 this->pressBetweenKeysUp.append(keyCode);
 
             } else if(settingPair.at(0) == "DOWN"){
                 KeySym keySym = XStringToKeysym(settingPair.at(1).toStdString().c_str());
-                KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                 this->pressBetweenKeysDown.append(keyCode);
 
             } else if(settingPair.at(0) == "LEFT"){
                 KeySym keySym = XStringToKeysym(settingPair.at(1).toStdString().c_str());
-                KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                 this->pressBetweenKeysLeft.append(keyCode);
 
             } else if(settingPair.at(0) == "RIGHT"){
                 KeySym keySym = XStringToKeysym(settingPair.at(1).toStdString().c_str());
-                KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+                KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
                 this->pressBetweenKeysRight.append(keyCode);
             } else {
                 error = true;
@@ -101,19 +101,6 @@ KeyScroll::KeyScroll(const QString &settings, Window window)
     if (error) {
         qWarning() << "Error reading KEYSCROLL settings, using the default settings";
     }
-    // Bring the window under the cursor to front, because only the window with the focus can receive keys
-    XClientMessageEvent event;
-    event.window = this-> window;
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_ACTIVE_WINDOW", false);
-    event.format = 32;
-    event.data.l[0] = 2;
-    event.data.l[1] = CurrentTime;
-    event.data.l[2] = 0;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
 }
 
 
@@ -122,92 +109,103 @@ KeyScroll::KeyScroll(const QString &settings, Window window)
 // ****************************************************************************************************************** //
 
 void KeyScroll::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
+    // Bring the window under the cursor to front, because only the window with the focus can receive keys. Done here
+    // and not in the constructor to make the request from the injection thread
+    XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "_NET_ACTIVE_WINDOW", 2, XCB_CURRENT_TIME);
+
         for (int n = 0; n < this->holdDownKeys.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->holdDownKeys.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), true, 0);
     }
 
 }
 
 void KeyScroll::executeUpdate(const QHash<QString, QVariant>& attrs)
 {
-    float deltaX = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat();
-    float deltaY = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat();
+    float deltaX = this->getDeltaX(attrs);
+    float deltaY = this->getDeltaY(attrs);
 
     // Vertical scroll
     if (deltaY > 0) {
-        this->downKeyScrollSpace += (int)deltaY;
+        this->downKeyScrollSpace += deltaY;
 
         while (this->downKeyScrollSpace >= this->verticalSpeed) {
             this->downKeyScrollSpace -= this->verticalSpeed;
             sendKeysDown();
             //DOWN
-            XFlush(QX11Info::display());
+            XCalls::flush(ActionInjector::display());
         }
 
     } else {
-        this->upKeyScrollSpace -= (int)deltaY;
+        this->upKeyScrollSpace -= deltaY;
 
         while (this->upKeyScrollSpace >= this->verticalSpeed) {
             this->upKeyScrollSpace -= this->verticalSpeed;
             sendKeysUp();
             //UP
-            XFlush(QX11Info::display());
+            XCalls::flush(ActionInjector::display());
         }
     }
 
     // Horizontal scroll
     if (deltaX > 0) {
-        this->rightKeyScrollSpace += (int)deltaX;
+        this->rightKeyScrollSpace += deltaX;
 
         while (this->rightKeyScrollSpace >= this->horizontalSpeed) {
             this->rightKeyScrollSpace -= this->horizontalSpeed;
             //RIGHT
             sendKeysRight();
-            XFlush(QX11Info::display());
+            XCalls::flush(ActionInjector::display());
         }
 
     } else {
-        this->leftKeyScrollSpace -= (int)deltaX;
+        this->leftKeyScrollSpace -= deltaX;
 
         while (this->leftKeyScrollSpace >= this->horizontalSpeed) {
             this->leftKeyScrollSpace -= this->horizontalSpeed;
             //LEFT
             sendKeysLeft();
-            XFlush(QX11Info::display());
+            XCalls::flush(ActionInjector::display());
         }
     }
 }
 
 void KeyScroll::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
         for (int n = 0; n < this->holdDownKeys.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->holdDownKeys.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), false, 0);
+    }
+}
+
+void KeyScroll::executeCancel() {
+    for (int n = 0; n < this->holdDownKeys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), false, 0);
     }
+    XCalls::flush(ActionInjector::display());
 }
 
 void KeyScroll::sendKeysUp() {
     for (int n = 0; n < this->pressBetweenKeysUp.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysUp.at(n), true, 0);
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysUp.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysUp.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysUp.at(n), false, 0);
     }
 }
 
 void KeyScroll::sendKeysDown() {
     for (int n = 0; n < this->pressBetweenKeysDown.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysDown.at(n), true, 0);
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysDown.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysDown.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysDown.at(n), false, 0);
     }
 }
 
 void KeyScroll::sendKeysRight() {
     for (int n = 0; n < this->pressBetweenKeysRight.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysRight.at(n), true, 0);
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysRight.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysRight.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysRight.at(n), false, 0);
     }
 }
 
 void KeyScroll::sendKeysLeft() {
     for (int n = 0; n < this->pressBetweenKeysDown.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysLeft.at(n), true, 0);
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeysLeft.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysLeft.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeysLeft.at(n), false, 0);
     }
 }
@@ -40,39 +40,41 @@ public:
 
     void executeFinish(const QHash<QString, QVariant>& attrs);
 
+    void executeCancel();
+
 private:
 
     /**
-     * KeyScroll speed. More is slower.
+     * KeyScroll speed: millimetres of displacement per step. More is slower.
      */
-    int horizontalSpeed;
+    float horizontalSpeed;
 
     /**
-     * KeyScroll speed. More is slower.
+     * KeyScroll speed: millimetres of displacement per step. More is slower.
      */
-    int verticalSpeed;
+    float verticalSpeed;
 
     //------------------------------------------------------------------------------------------------------------------
 
     /**
-     * Accumulated space to scrolling up.
+     * Accumulated millimetres to scrolling up.
      */
-    int upKeyScrollSpace;
+    float upKeyScrollSpace;
 
     /**
-     * Accumulated space to scrolling down.
+     * Accumulated millimetres to scrolling down.
      */
-    int downKeyScrollSpace;
+    float downKeyScrollSpace;
 
     /**
-     * Accumulated space to scrolling left.
+     * Accumulated millimetres to scrolling left.
      */
-    int leftKeyScrollSpace;
+    float leftKeyScrollSpace;
 
     /**
-     * Accumulated space to scrolling right.
+     * Accumulated millimetres to scrolling right.
      */
-    int rightKeyScrollSpace;
+    float rightKeyScrollSpace;
 
     //------------------------------------------------------------------------------------------------------------------
     protected:
@@ -38,53 +38,35 @@ void MaximizeRestoreWindow::executeStart(const QHash<QString, QVariant>&) {
     }
 }
 
-void MaximizeRestoreWindow::executeUpdate(const QHash<QString, QVariant>&) {}
+void MaximizeRestoreWindow::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        maximizeRestoreWindow();
+    }
+}
 
 void MaximizeRestoreWindow::executeFinish(const QHash<QString, QVariant>&) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         maximizeRestoreWindow();
     }
 }
 
+bool MaximizeRestoreWindow::canRunSpeculatively() const {
+    // The window stays available for the composed gesture and the next execution restores it
+    return true;
+}
+
 void MaximizeRestoreWindow::maximizeRestoreWindow() {
     if (this->window == None)
         return;
 
-    Atom atomMaxVert = XInternAtom(QX11Info::display(), "_NET_WM_STATE_MAXIMIZED_VERT", false);
-    Atom atomMaxHorz = XInternAtom(QX11Info::display(), "_NET_WM_STATE_MAXIMIZED_HORZ", false);
+    Display *display = ActionInjector::display();
+    xcb_atom_t atomMaxVert = XcbCalls::atom(display, "_NET_WM_STATE_MAXIMIZED_VERT");
+    xcb_atom_t atomMaxHorz = XcbCalls::atom(display, "_NET_WM_STATE_MAXIMIZED_HORZ");
 
     // Check if the window is maximized
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
-
-    XGetWindowProperty(QX11Info::display(), this->window, XInternAtom(QX11Info::display(), "_NET_WM_STATE", false),
-            0, 100, false, XA_ATOM, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet);
-    Atom *states = (Atom *)propRet;
-
-    bool maxHor  = false;
-    bool maxVert = false;
-    for (unsigned int n = 0; n < numItems; n++) {
-        if (states[n] == atomMaxVert)
-            maxVert = true;
-        if (states[n] == atomMaxHorz)
-            maxHor = true;
-    }
-    bool maximized = maxHor && maxVert;
-    XFree(propRet);
+    QList<quint32> states = XcbCalls::getProperty(display, this->window, "_NET_WM_STATE", XCB_ATOM_ATOM);
+    bool maximized = states.contains(atomMaxVert) && states.contains(atomMaxHorz);
 
     // If the window is maximized restore it
-    XClientMessageEvent event;
-    event.window = this-> window;
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_WM_STATE", false);
-    event.format = 32;
-    event.data.l[0] = maximized ? 0 : 1;
-    event.data.l[1] = atomMaxVert;
-    event.data.l[2] = atomMaxHorz;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
+    XcbCalls::sendClientMessage(display, this->window, "_NET_WM_STATE", maximized ? 0 : 1, atomMaxVert, atomMaxHorz);
 }
@@ -38,10 +38,14 @@ void MinimizeWindow::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void MinimizeWindow::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void MinimizeWindow::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        minimizeWindow();
+    }
+}
 
 void MinimizeWindow::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         minimizeWindow();
     }
 }
@@ -51,14 +55,5 @@ void MinimizeWindow::minimizeWindow() {
         return;
 
     // Minimize the window
-    XClientMessageEvent event;
-    event.window = this->window;
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "WM_CHANGE_STATE", false);
-    event.format = 32;
-    event.data.l[0] = IconicState;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
+    XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "WM_CHANGE_STATE", IconicState);
 }
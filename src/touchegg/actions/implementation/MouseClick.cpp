@@ -53,17 +53,21 @@ void MouseClick::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void MouseClick::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void MouseClick::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        mouseClick();
+    }
+}
 
 void MouseClick::executeFinish(const QHash<QString, QVariant>& /*attrs*/)
 {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         mouseClick();
     }
 }
 
 void MouseClick::mouseClick() {
-    XTestFakeButtonEvent(QX11Info::display(), this->button, true, 0);
-    XTestFakeButtonEvent(QX11Info::display(), this->button, false, 0);
-    XFlush(QX11Info::display());
+    XCalls::testFakeButtonEvent(ActionInjector::display(), this->button, true, 0);
+    XCalls::testFakeButtonEvent(ActionInjector::display(), this->button, false, 0);
+    XCalls::flush(ActionInjector::display());
 }
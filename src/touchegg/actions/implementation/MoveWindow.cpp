@@ -34,9 +34,10 @@ MoveWindow::MoveWindow(const QString &settings, Window window)
 
 void MoveWindow::executeStart(const QHash<QString, QVariant>& /*attrs*/)
 {
-    XTestFakeKeyEvent(QX11Info::display(), XKeysymToKeycode(QX11Info::display(), XK_Alt_L), true, 0);
-    XTestFakeButtonEvent(QX11Info::display(), Button1, true, 0);
-    XFlush(QX11Info::display());
+    XCalls::testFakeKeyEvent(ActionInjector::display(), XKeysymToKeycode(ActionInjector::display(), XK_Alt_L),
+            true, 0);
+    XCalls::testFakeButtonEvent(ActionInjector::display(), Button1, true, 0);
+    XCalls::flush(ActionInjector::display());
 }
 
 void MoveWindow::executeUpdate(const QHash<QString, QVariant>& attrs)
@@ -44,16 +45,21 @@ void MoveWindow::executeUpdate(const QHash<QString, QVariant>& attrs)
     if (!attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_X) || !attrs.contains(GEIS_GESTURE_ATTRIBUTE_DELTA_Y))
         return;
 
-    XTestFakeRelativeMotionEvent(QX11Info::display(),
-            + attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat() * 0.1,
-            + attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat() * 0.1, 0);
+    XCalls::testFakeRelativeMotionEvent(ActionInjector::display(),
+            this->getPixelsX(attrs), this->getPixelsY(attrs), 0);
 
-    XFlush(QX11Info::display());
+    XCalls::flush(ActionInjector::display());
 }
 
 void MoveWindow::executeFinish(const QHash<QString, QVariant>& /*attrs*/)
 {
-    XTestFakeKeyEvent(QX11Info::display(), XKeysymToKeycode(QX11Info::display(), XK_Alt_L), false, 0);
-    XTestFakeButtonEvent(QX11Info::display(), Button1, false, 0);
-    XFlush(QX11Info::display());
+    this->executeCancel();
+}
+
+void MoveWindow::executeCancel()
+{
+    XCalls::testFakeKeyEvent(ActionInjector::display(), XKeysymToKeycode(ActionInjector::display(), XK_Alt_L),
+            false, 0);
+    XCalls::testFakeButtonEvent(ActionInjector::display(), Button1, false, 0);
+    XCalls::flush(ActionInjector::display());
 }
@@ -39,6 +39,8 @@ public:
     void executeUpdate(const QHash<QString, QVariant>& attrs);
 
     void executeFinish(const QHash<QString, QVariant>& attrs);
+
+    void executeCancel();
 };
 
 #endif // MOVEWINDOW_H
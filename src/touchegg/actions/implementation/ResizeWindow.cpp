@@ -38,23 +38,17 @@ void ResizeWindow::executeStart(const QHash<QString, QVariant>& /*attrs*/)
         return;
 
     // Check if the window to resize is special (toolbar, descktop...) to not resize it
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
+    Display *display = ActionInjector::display();
+    QList<quint32> types = XcbCalls::getProperty(display, this->window, "_NET_WM_WINDOW_TYPE", XCB_ATOM_ATOM);
 
-    if (XGetWindowProperty(QX11Info::display(), this->window,
-            XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE", false),
-            0, 100, false, XA_ATOM, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet) == Success) {
-        Atom *types = (Atom *)propRet;
-        Atom type = types[0]; // Only check the first type
+    if (!types.isEmpty()) {
+        xcb_atom_t type = types.first(); // Only check the first type
 
-        if (type == XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE_DESKTOP", false)
-                || type == XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE_DOCK", false)
-                || type == XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE_SPLASH", false)) {
+        if (type == XcbCalls::atom(display, "_NET_WM_WINDOW_TYPE_DESKTOP")
+                || type == XcbCalls::atom(display, "_NET_WM_WINDOW_TYPE_DOCK")
+                || type == XcbCalls::atom(display, "_NET_WM_WINDOW_TYPE_SPLASH")) {
             this->window = 0;
         }
-        XFree(propRet);
     }
 }
 
@@ -89,14 +83,15 @@ void ResizeWindow::executeUpdate(const QHash<QString, QVariant>& attrs)
         incY = sin(angle * (3.14 / 180));
     }
 
-    // Resize the window
+    // Resize the window in the same proportion as the radius, the radius delta is the ratio between the new and the
+    // previous radius
     XWindowAttributes xwa;
-    XGetWindowAttributes(QX11Info::display(), this->window, &xwa);
-    int inc = (int)attrs.value(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA).toFloat() * 10;
-    XResizeWindow(QX11Info::display(), this->window,
-            xwa.width  + inc * incX,
-            xwa.height + inc * incY);
-    XFlush(QX11Info::display());
+    XCalls::getWindowAttributes(ActionInjector::display(), this->window, &xwa);
+    float inc = attrs.value(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA, 1.0f).toFloat() - 1;
+    XCalls::resizeWindow(ActionInjector::display(), this->window,
+            xwa.width  + xwa.width  * inc * incX,
+            xwa.height + xwa.height * inc * incY);
+    XCalls::flush(ActionInjector::display());
 }
 
 void ResizeWindow::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {}
@@ -0,0 +1,153 @@
+/**
+ * @file /src/touchegg/actions/implementation/Rotate.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Rotate
+ */
+#include "Rotate.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+Rotate::Rotate(const QString &settings, Window window)
+    : Action(settings, window),
+      stepAngle(15 * M_PI / 180),
+      angle(0)
+{
+    bool error = false;
+
+    foreach(QString setting, settings.split(":", QString::SkipEmptyParts)) {
+        QStringList settingPair = setting.trimmed().split("=");
+        if (settingPair.length() != 2) {
+            error = true;
+            continue;
+        }
+
+        if (settingPair.at(0) == "STEP") {
+            bool ok;
+            float degrees = settingPair.at(1).toFloat(&ok);
+            if (ok && degrees > 0 && degrees <= 360)
+                this->stepAngle = degrees * M_PI / 180;
+            else
+                error = true;
+
+        } else if (settingPair.at(0) == "LEFT") {
+            error |= !Rotate::readStep(settingPair.at(1), this->left);
+
+        } else if (settingPair.at(0) == "RIGHT") {
+            error |= !Rotate::readStep(settingPair.at(1), this->right);
+
+        } else {
+            error = true;
+        }
+    }
+
+    if (error) {
+        qWarning() << "Error reading ROTATE settings, using the default settings where they are wrong";
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void Rotate::executeStart(const QHash<QString, QVariant>& /*attrs*/)
+{
+    // Bring the window under the cursor to front, because only the window with the focus can receive keys. Done here
+    // and not in the constructor to make the request from the injection thread
+    XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "_NET_ACTIVE_WINDOW", 2, XCB_CURRENT_TIME);
+}
+
+void Rotate::executeUpdate(const QHash<QString, QVariant>& attrs)
+{
+    this->angle += attrs.value(GEIS_GESTURE_ATTRIBUTE_ANGLE_DELTA).toFloat();
+
+    // Steps crossed by the update, keeping the rest of the angle for the next updates
+    int numSteps = (int)(this->angle / this->stepAngle);
+    if (numSteps == 0)
+        return;
+
+    this->angle -= numSteps * this->stepAngle;
+
+    if (numSteps > 0)
+        this->sendSteps(this->right, numSteps);
+    else
+        this->sendSteps(this->left, -numSteps);
+
+    XCalls::flush(ActionInjector::display());
+}
+
+void Rotate::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+bool Rotate::readStep(const QString &value, Step &step)
+{
+    bool ok = true;
+
+    foreach(QString key, value.split("+", QString::SkipEmptyParts)) {
+        key = key.trimmed();
+
+        if (key == "Control" || key == "Shift" || key == "Super" || key == "Alt" || key == "AltGr") {
+            step.holdDownKeys.append(Action::getKeyCode(key));
+
+        } else if (key.startsWith("Button")) {
+            bool isNumber;
+            unsigned int button = key.mid(6).toUInt(&isNumber);
+            if (isNumber && button >= 1 && button <= 9)
+                step.buttons.append(button);
+            else
+                ok = false;
+
+        } else {
+            KeyCode keyCode = Action::getKeyCode(key);
+            if (keyCode != 0)
+                step.pressBetweenKeys.append(keyCode);
+            else
+                ok = false;
+        }
+    }
+
+    return ok;
+}
+
+void Rotate::sendSteps(const Step &step, int numSteps)
+{
+    for (int n = 0; n < step.holdDownKeys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), step.holdDownKeys.at(n), true, 0);
+    }
+
+    for (int s = 0; s < numSteps; s++) {
+        for (int n = 0; n < step.pressBetweenKeys.length(); n++) {
+            XCalls::testFakeKeyEvent(ActionInjector::display(), step.pressBetweenKeys.at(n), true, 0);
+            XCalls::testFakeKeyEvent(ActionInjector::display(), step.pressBetweenKeys.at(n), false, 0);
+        }
+        for (int n = 0; n < step.buttons.length(); n++) {
+            XCalls::testFakeButtonEvent(ActionInjector::display(), step.buttons.at(n), true, 0);
+            XCalls::testFakeButtonEvent(ActionInjector::display(), step.buttons.at(n), false, 0);
+        }
+    }
+
+    for (int n = 0; n < step.holdDownKeys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), step.holdDownKeys.at(n), false, 0);
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file /src/touchegg/actions/implementation/Rotate.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Rotate
+ */
+#ifndef ROTATE_H
+#define ROTATE_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/actions/implementation/Action.h"
+
+/**
+ * Follows a rotation, sending keys or mouse buttons each time the fingers turn the configured angle.
+ *
+ * The settings are a list of "NAME=VALUE" separated by ":":
+ *  - STEP: Degrees of each step, 15 by default.
+ *  - LEFT and RIGHT: What to send on each step counterclockwise and clockwise. A list of keys separated by "+", as
+ *    in SEND_KEYS, where the modifiers are held down while the rest of keys are pressed. "Button<N>" sends the mouse
+ *    button N instead of a key.
+ * For example, "STEP=10:LEFT=Control+bracketleft:RIGHT=Control+bracketright" or
+ * "LEFT=Shift+Button4:RIGHT=Shift+Button5".
+ */
+class Rotate : public Action
+{
+
+public:
+
+    Rotate(const QString &settings, Window window);
+
+    void executeStart(const QHash<QString, QVariant>& attrs);
+
+    void executeUpdate(const QHash<QString, QVariant>& attrs);
+
+    void executeFinish(const QHash<QString, QVariant>& attrs);
+
+private:
+
+    /**
+     * What to send on each step of a direction.
+     */
+    struct Step {
+        /**
+         * Keys to hold down while sending the steps of an update.
+         */
+        QList<KeyCode> holdDownKeys;
+
+        /**
+         * Keys pressed on each step.
+         */
+        QList<KeyCode> pressBetweenKeys;
+
+        /**
+         * Mouse buttons pressed on each step.
+         */
+        QList<unsigned int> buttons;
+    };
+
+    /**
+     * Reads what to send on each step of a direction.
+     * @param  value The setting.
+     * @param  step  The keys and buttons read.
+     * @return If the setting is correct.
+     */
+    static bool readStep(const QString &value, Step &step);
+
+    /**
+     * Sends the steps of an update, holding down the modifiers once for all of them.
+     * @param step     What to send.
+     * @param numSteps Number of steps.
+     */
+    void sendSteps(const Step &step, int numSteps);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Angle of each step, in radians.
+     */
+    float stepAngle;
+
+    /**
+     * Angle accumulated since the last step, in radians. Positive clockwise.
+     */
+    float angle;
+
+    /**
+     * What to send on each step counterclockwise and clockwise.
+     */
+    Step left;
+    Step right;
+
+};
+
+#endif // ROTATE_H
@@ -27,7 +27,7 @@
 RunCommand::RunCommand(const QString &settings, const QString &timing, Window window)
     : Action(settings, timing, window)
 {
-    this->command = settings;
+    this->arguments = CommandLauncher::tokenize(settings);
 }
 
 
@@ -41,18 +41,23 @@ void RunCommand::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void RunCommand::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void RunCommand::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        runCommand();
+    }
+}
 
 void RunCommand::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         runCommand();
     }
 }
 
 
 void RunCommand::runCommand() {
-    if (this->command != "") {
-        QProcess *myProcess = new QProcess();
-        myProcess->startDetached(this->command);
-    }
+    if (this->arguments.isEmpty())
+        return;
+
+    if (!CommandLauncher::getInstance()->launch(this->arguments))
+        QProcess::startDetached(this->arguments.first(), this->arguments.mid(1));
 }
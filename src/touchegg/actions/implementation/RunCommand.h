@@ -24,9 +24,11 @@
 
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/actions/implementation/Action.h"
+#include "src/touchegg/launcher/CommandLauncher.h"
 
 /**
- * Runs the command specified in the configuration.
+ * Runs the command specified in the configuration, through the CommandLauncher or, if it is not running, with
+ * QProcess.
  */
 class RunCommand : public Action
 {
@@ -48,9 +50,9 @@ protected:
     void runCommand();
 
     /**
-     * Command to execute.
+     * Command to execute, split in the program and its arguments when the action is created.
      */
-    QString command;
+    QStringList arguments;
 
 };
 
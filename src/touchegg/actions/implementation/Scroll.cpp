@@ -26,8 +26,8 @@
 
 Scroll::Scroll(const QString &settings, Window window)
     : Action(settings, window),
-      horizontalSpeed(30),
-      verticalSpeed(30),
+      horizontalSpeed(7.5),
+      verticalSpeed(7.5),
       upScrollSpace(0),
       downScrollSpace(0),
       leftScrollSpace(0),
@@ -49,8 +49,8 @@ Scroll::Scroll(const QString &settings, Window window)
         bool ok;
         int configSpeed = QString(mainStrSpeed.at(1)).toInt(&ok);
         if (ok && configSpeed >= 1 && configSpeed <= 10) {
-            this->verticalSpeed   = 40 - 2 * configSpeed;
-            this->horizontalSpeed = 40 - 2 * configSpeed;
+            this->verticalSpeed   = 10 - 0.5 * configSpeed;
+            this->horizontalSpeed = 10 - 0.5 * configSpeed;
         } else {
             error = true;
         }
@@ -86,50 +86,50 @@ void Scroll::executeStart(const QHash<QString, QVariant>& /*attrs*/) {}
 
 void Scroll::executeUpdate(const QHash<QString, QVariant>& attrs)
 {
-    float deltaX = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat();
-    float deltaY = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat();
+    float deltaX = this->getDeltaX(attrs);
+    float deltaY = this->getDeltaY(attrs);
 
     // Vertical scroll
     if (deltaY > 0) {
-        this->downScrollSpace += (int)deltaY;
+        this->downScrollSpace += deltaY;
 
         while (this->downScrollSpace >= this->verticalSpeed) {
             this->downScrollSpace -= this->verticalSpeed;
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonDown, true, 0);
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonDown, false, 0);
-            XFlush(QX11Info::display());
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonDown, true, 0);
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonDown, false, 0);
+            XCalls::flush(ActionInjector::display());
         }
 
     } else {
-        this->upScrollSpace -= (int)deltaY;
+        this->upScrollSpace -= deltaY;
 
         while (this->upScrollSpace >= this->verticalSpeed) {
             this->upScrollSpace -= this->verticalSpeed;
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonUp, true, 0);
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonUp, false, 0);
-            XFlush(QX11Info::display());
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonUp, true, 0);
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonUp, false, 0);
+            XCalls::flush(ActionInjector::display());
         }
     }
 
     // Horizontal scroll
     if (deltaX > 0) {
-        this->rightScrollSpace += (int)deltaX;
+        this->rightScrollSpace += deltaX;
 
         while (this->rightScrollSpace >= this->horizontalSpeed) {
             this->rightScrollSpace -= this->horizontalSpeed;
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonRight, true, 0);
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonRight, false, 0);
-            XFlush(QX11Info::display());
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonRight, true, 0);
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonRight, false, 0);
+            XCalls::flush(ActionInjector::display());
         }
 
     } else {
-        this->leftScrollSpace -= (int)deltaX;
+        this->leftScrollSpace -= deltaX;
 
         while (this->leftScrollSpace >= this->horizontalSpeed) {
             this->leftScrollSpace -= this->horizontalSpeed;
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonLeft, true, 0);
-            XTestFakeButtonEvent(QX11Info::display(), this->buttonLeft, false, 0);
-            XFlush(QX11Info::display());
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonLeft, true, 0);
+            XCalls::testFakeButtonEvent(ActionInjector::display(), this->buttonLeft, false, 0);
+            XCalls::flush(ActionInjector::display());
         }
     }
 }
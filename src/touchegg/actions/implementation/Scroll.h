@@ -43,36 +43,36 @@ public:
 private:
 
     /**
-     * Scroll speed. More is slower.
+     * Scroll speed: millimetres of displacement per step. More is slower.
      */
-    int horizontalSpeed;
+    float horizontalSpeed;
 
     /**
-     * Scroll speed. More is slower.
+     * Scroll speed: millimetres of displacement per step. More is slower.
      */
-    int verticalSpeed;
+    float verticalSpeed;
 
     //------------------------------------------------------------------------------------------------------------------
 
     /**
-     * Accumulated space to scrolling up.
+     * Accumulated millimetres to scrolling up.
      */
-    int upScrollSpace;
+    float upScrollSpace;
 
     /**
-     * Accumulated space to scrolling down.
+     * Accumulated millimetres to scrolling down.
      */
-    int downScrollSpace;
+    float downScrollSpace;
 
     /**
-     * Accumulated space to scrolling left.
+     * Accumulated millimetres to scrolling left.
      */
-    int leftScrollSpace;
+    float leftScrollSpace;
 
     /**
-     * Accumulated space to scrolling right.
+     * Accumulated millimetres to scrolling right.
      */
-    int rightScrollSpace;
+    float rightScrollSpace;
 
     //------------------------------------------------------------------------------------------------------------------
 
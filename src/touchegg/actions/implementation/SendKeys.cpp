@@ -34,34 +34,20 @@ SendKeys::SendKeys(const QString &settings, const QString &timing, Window window
         if (key == "Control" || key == "Shift" || key == "Super" || key == "Alt") {
             key = key.append("_L");
             KeySym keySym = XStringToKeysym(key.toStdString().c_str());
-            KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+            KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
             this->holdDownKeys.append(keyCode);
 
         } else if (key == "AltGr") {
             KeySym keySym = XStringToKeysym("Alt_R");
-            KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+            KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
             this->holdDownKeys.append(keyCode);
 
         } else {
             KeySym keySym = XStringToKeysym(key.toStdString().c_str());
-            KeyCode keyCode = XKeysymToKeycode(QX11Info::display(), keySym);
+            KeyCode keyCode = XKeysymToKeycode(XConnection::display(), keySym);
             this->pressBetweenKeys.append(keyCode);
         }
     }
-
-    // Bring the window under the cursor to front, because only the window with the focus can receive keys
-    XClientMessageEvent event;
-    event.window = this-> window;
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_ACTIVE_WINDOW", false);
-    event.format = 32;
-    event.data.l[0] = 2;
-    event.data.l[1] = CurrentTime;
-    event.data.l[2] = 0;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
 }
 
 
@@ -70,30 +56,38 @@ SendKeys::SendKeys(const QString &settings, const QString &timing, Window window
 // ****************************************************************************************************************** //
 
 void SendKeys::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
+    // Bring the window under the cursor to front, because only the window with the focus can receive keys. Done here
+    // and not in the constructor to make the request from the injection thread
+    XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "_NET_ACTIVE_WINDOW", 2, XCB_CURRENT_TIME);
+
     if (at_start) {
         sendKeys();
     }
 }
 
-void SendKeys::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void SendKeys::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        sendKeys();
+    }
+}
 
 void SendKeys::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         sendKeys();
     }
 }
 
 void SendKeys::sendKeys() {
     for (int n = 0; n < this->holdDownKeys.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->holdDownKeys.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), true, 0);
     }
 
     for (int n = 0; n < this->pressBetweenKeys.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeys.at(n), true, 0);
-        XTestFakeKeyEvent(QX11Info::display(), this->pressBetweenKeys.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeys.at(n), true, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->pressBetweenKeys.at(n), false, 0);
     }
 
     for (int n = 0; n < this->holdDownKeys.length(); n++) {
-        XTestFakeKeyEvent(QX11Info::display(), this->holdDownKeys.at(n), false, 0);
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), false, 0);
     }
 }
@@ -38,40 +38,29 @@ void ShowDesktop::executeStart(const QHash<QString, QVariant>& /*attrs*/) {
     }
 }
 
-void ShowDesktop::executeUpdate(const QHash<QString, QVariant>& /*attrs*/) {}
+void ShowDesktop::executeUpdate(const QHash<QString, QVariant>& attrs) {
+    if (isUpdateStep(attrs)) {
+        showDesktop();
+    }
+}
 
 void ShowDesktop::executeFinish(const QHash<QString, QVariant>& /*attrs*/) {
-    if (!at_start) {
+    if (!at_start && !at_update) {
         showDesktop();
     }
 }
 
 void ShowDesktop::showDesktop() {
     // Check if it is already in show desktop mode
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
+    QList<quint32> showingDesktop = XcbCalls::getProperty(ActionInjector::display(), XConnection::rootWindow(),
+            "_NET_SHOWING_DESKTOP", XCB_ATOM_CARDINAL);
 
-    XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(),
-            XInternAtom(QX11Info::display(), "_NET_SHOWING_DESKTOP", false),
-            0, 1, false, XA_CARDINAL, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet);
-
-    if (propRet == NULL)
+    if (showingDesktop.isEmpty())
         return;
 
-    bool isShowingDesktop = *((bool *) propRet);
-    XFree(propRet);
+    bool isShowingDesktop = showingDesktop.first() != 0;
 
     // Minimize or restore the windows
-    XClientMessageEvent event;
-    event.window = QX11Info::appRootWindow(QX11Info::appScreen());
-    event.type = ClientMessage;
-    event.message_type = XInternAtom(QX11Info::display(), "_NET_SHOWING_DESKTOP", false);
-    event.format = 32;
-    event.data.l[0] = !isShowingDesktop;
-
-    XSendEvent(QX11Info::display(), QX11Info::appRootWindow(QX11Info::appScreen()), false,
-            (SubstructureNotifyMask | SubstructureRedirectMask), (XEvent *)&event);
-    XFlush(QX11Info::display());
+    XcbCalls::sendClientMessage(ActionInjector::display(), XConnection::rootWindow(), "_NET_SHOWING_DESKTOP",
+            !isShowingDesktop);
 }
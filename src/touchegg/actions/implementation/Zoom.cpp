@@ -0,0 +1,224 @@
+/**
+ * @file /src/touchegg/actions/implementation/Zoom.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Zoom
+ */
+#include "Zoom.h"
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    // Fraction of the step added to the first step in the direction contrary to the previous one, so the trembling of
+    // the fingers at the end of a pinch doesn't undo the last step
+    const float HYSTERESIS = 0.5f;
+
+    // Mouse buttons of the wheel
+    const unsigned int BUTTON_WHEEL_UP   = 4;
+    const unsigned int BUTTON_WHEEL_DOWN = 5;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+Zoom::Zoom(const QString &settings, Window window)
+    : Action(settings, window),
+      threshold(std::log(1.1f)),
+      rate(20),
+      level(0),
+      lastDirection(0),
+      inverted(false)
+{
+    bool error = false;
+    bool defaultModifiers = true;
+
+    foreach(QString setting, settings.split(":", QString::SkipEmptyParts)) {
+        QStringList settingPair = setting.trimmed().split("=");
+        if (settingPair.length() != 2) {
+            error = true;
+            continue;
+        }
+
+        QString name  = settingPair.at(0);
+        QString value = settingPair.at(1);
+        bool ok = true;
+
+        if (name == "STEP") {
+            float step = value.toFloat(&ok);
+            if (ok && step > 0 && step <= 100)
+                this->threshold = std::log(1 + step / 100);
+            else
+                error = true;
+
+        } else if (name == "RATE") {
+            float rate = value.toFloat(&ok);
+            if (ok && rate >= 0)
+                this->rate = rate;
+            else
+                error = true;
+
+        } else if (name == "INVERTED") {
+            if (value == "true" || value == "false")
+                this->inverted = (value == "true");
+            else
+                error = true;
+
+        } else if (name == "MOD") {
+            if (Zoom::readKeys(value, this->holdDownKeys))
+                defaultModifiers = false;
+            else
+                error = true;
+
+        } else if (name == "IN") {
+            error |= !Zoom::readKeys(value, this->zoomInKeys);
+
+        } else if (name == "OUT") {
+            error |= !Zoom::readKeys(value, this->zoomOutKeys);
+
+        } else {
+            error = true;
+        }
+    }
+
+    // The keys must be configured in both directions, otherwise the mouse wheel is used
+    if (this->zoomInKeys.isEmpty() != this->zoomOutKeys.isEmpty()) {
+        this->zoomInKeys.clear();
+        this->zoomOutKeys.clear();
+        error = true;
+    }
+
+    if (defaultModifiers)
+        error |= !Zoom::readKeys("Control", this->holdDownKeys);
+
+    if (error) {
+        qWarning() << "Error reading ZOOM settings, using the default settings where they are wrong";
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void Zoom::executeStart(const QHash<QString, QVariant>& /*attrs*/)
+{
+    // The keys are only received by the window with the focus, the mouse wheel by the window under the cursor. Done
+    // here and not in the constructor to make the request from the injection thread
+    if (!this->zoomInKeys.isEmpty())
+        XcbCalls::sendClientMessage(ActionInjector::display(), this->window, "_NET_ACTIVE_WINDOW", 2,
+                XCB_CURRENT_TIME);
+
+    for (int n = 0; n < this->holdDownKeys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), true, 0);
+    }
+    XCalls::flush(ActionInjector::display());
+}
+
+void Zoom::executeUpdate(const QHash<QString, QVariant>& attrs)
+{
+    this->refillTokens(attrs, this->rate);
+
+    float radiusDelta = attrs.value(GEIS_GESTURE_ATTRIBUTE_RADIUS_DELTA, 1.0f).toFloat();
+    if (radiusDelta <= 0)
+        return;
+
+    this->level += std::log(radiusDelta);
+
+    bool sent = false;
+    forever {
+        int direction = (this->level > 0) ? 1 : -1;
+        float step = (direction == -this->lastDirection) ? this->threshold * (1 + HYSTERESIS) : this->threshold;
+        if (std::fabs(this->level) < step)
+            break;
+
+        // Without tokens only one step is kept pending, so the zoom stops with the fingers instead of sending the
+        // queued steps
+        if (!this->takeToken(this->rate)) {
+            this->level = direction * step;
+            break;
+        }
+
+        this->level -= direction * step;
+        this->lastDirection = direction;
+        this->sendStep((direction > 0) != this->inverted);
+        sent = true;
+    }
+
+    if (sent)
+        XCalls::flush(ActionInjector::display());
+}
+
+void Zoom::executeFinish(const QHash<QString, QVariant>& /*attrs*/)
+{
+    this->releaseModifiers();
+}
+
+void Zoom::executeCancel()
+{
+    this->releaseModifiers();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void Zoom::sendStep(bool zoomIn)
+{
+    if (this->zoomInKeys.isEmpty()) {
+        unsigned int button = zoomIn ? BUTTON_WHEEL_UP : BUTTON_WHEEL_DOWN;
+        XCalls::testFakeButtonEvent(ActionInjector::display(), button, true, 0);
+        XCalls::testFakeButtonEvent(ActionInjector::display(), button, false, 0);
+        return;
+    }
+
+    const QList<KeyCode> &keys = zoomIn ? this->zoomInKeys : this->zoomOutKeys;
+    for (int n = 0; n < keys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), keys.at(n), true, 0);
+    }
+    for (int n = keys.length() - 1; n >= 0; n--) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), keys.at(n), false, 0);
+    }
+}
+
+void Zoom::releaseModifiers()
+{
+    for (int n = 0; n < this->holdDownKeys.length(); n++) {
+        XCalls::testFakeKeyEvent(ActionInjector::display(), this->holdDownKeys.at(n), false, 0);
+    }
+    XCalls::flush(ActionInjector::display());
+}
+
+bool Zoom::readKeys(const QString &value, QList<KeyCode> &keys)
+{
+    QList<KeyCode> ret;
+    foreach(QString key, value.split("+", QString::SkipEmptyParts)) {
+        KeyCode keyCode = Action::getKeyCode(key);
+        if (keyCode == 0)
+            return false;
+
+        ret.append(keyCode);
+    }
+
+    keys = ret;
+    return true;
+}
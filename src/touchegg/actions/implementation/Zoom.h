@@ -0,0 +1,118 @@
+/**
+ * @file /src/touchegg/actions/implementation/Zoom.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Zoom
+ */
+#ifndef ZOOM_H
+#define ZOOM_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/actions/implementation/Action.h"
+
+/**
+ * Zooms in or out while pinching, sending a zoom step each time the distance between the fingers changes in the
+ * configured proportion. Spreading the fingers zooms in and closing them zooms out. By default the steps are Control +
+ * mouse wheel, but they can be keys. The modifiers are held down during the whole gesture and not for each step.
+ *
+ * The settings are a list of "NAME=VALUE" separated by ":", all of them optional:
+ *  - STEP: Percentage that the distance between the fingers must grow or shrink to send a step, 10 by default.
+ *  - RATE: Maximum number of steps per second, 20 by default and 0 for no limit.
+ *  - MOD:  Modifiers held down during the gesture, separated by "+". "Control" by default.
+ *  - IN and OUT: Keys to send to zoom in and out, instead of the mouse wheel.
+ *  - INVERTED: "true" to zoom in when the fingers close, as the PINCH IN gestures of previous versions. "false" by
+ *    default.
+ * For example, "STEP=15:MOD=Control:IN=KP_Add:OUT=KP_Subtract".
+ */
+class Zoom : public Action
+{
+
+public:
+
+    Zoom(const QString &settings, Window window);
+
+    void executeStart(const QHash<QString, QVariant>& attrs);
+
+    void executeUpdate(const QHash<QString, QVariant>& attrs);
+
+    void executeFinish(const QHash<QString, QVariant>& attrs);
+
+    void executeCancel();
+
+private:
+
+    /**
+     * Sends a zoom step.
+     * @param zoomIn Zoom in or zoom out.
+     */
+    void sendStep(bool zoomIn);
+
+    /**
+     * Releases the modifiers.
+     */
+    void releaseModifiers();
+
+    /**
+     * Reads a combination of keys, separated by "+".
+     * @param  value The setting.
+     * @param  keys  The keys read. Not modified if the setting is wrong.
+     * @return If the setting is correct, all the keys exist.
+     */
+    static bool readKeys(const QString &value, QList<KeyCode> &keys);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Logarithm of the proportion between the distances of the fingers that sends a step.
+     */
+    float threshold;
+
+    /**
+     * Maximum number of steps per second, 0 for no limit.
+     */
+    float rate;
+
+    /**
+     * Logarithm of the proportion between the distances of the fingers accumulated since the last step. The pinch
+     * reports the proportion of each update, so the logarithms are added instead of multiplying the proportions.
+     */
+    float level;
+
+    /**
+     * Direction of the last step, 1 if the fingers spread, -1 if they close and 0 before the first step.
+     */
+    int lastDirection;
+
+    /**
+     * If closing the fingers zooms in.
+     */
+    bool inverted;
+
+    /**
+     * Modifiers to hold down during the gesture.
+     */
+    QList<KeyCode> holdDownKeys;
+
+    /**
+     * Keys to send to zoom in and out, empty to use the mouse wheel.
+     */
+    QList<KeyCode> zoomInKeys;
+    QList<KeyCode> zoomOutKeys;
+
+};
+
+#endif // ZOOM_H
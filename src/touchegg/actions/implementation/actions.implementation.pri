@@ -14,9 +14,12 @@ HEADERS += \
     src/touchegg/actions/implementation/ChangeViewport.h \
     src/touchegg/actions/implementation/MouseClick.h \
     src/touchegg/actions/implementation/Scroll.h \
-    src/touchegg/actions/implementation/KeyScroll.h
+    src/touchegg/actions/implementation/KeyScroll.h \
+    src/touchegg/actions/implementation/Zoom.h \
+    src/touchegg/actions/implementation/Rotate.h
 
 SOURCES += \
+    src/touchegg/actions/implementation/Action.cpp \
     src/touchegg/actions/implementation/MinimizeWindow.cpp \
     src/touchegg/actions/implementation/CloseWindow.cpp \
     src/touchegg/actions/implementation/MaximizeRestoreWindow.cpp \
@@ -30,4 +33,6 @@ SOURCES += \
     src/touchegg/actions/implementation/ChangeViewport.cpp \
     src/touchegg/actions/implementation/MouseClick.cpp \
     src/touchegg/actions/implementation/Scroll.cpp \
-    src/touchegg/actions/implementation/KeyScroll.cpp
+    src/touchegg/actions/implementation/KeyScroll.cpp \
+    src/touchegg/actions/implementation/Zoom.cpp \
+    src/touchegg/actions/implementation/Rotate.cpp
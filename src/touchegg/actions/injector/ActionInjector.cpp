@@ -0,0 +1,187 @@
+/**
+ * @file /src/touchegg/actions/injector/ActionInjector.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  ActionInjector
+ */
+#include "ActionInjector.h"
+#include "src/touchegg/actions/implementation/Action.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+ActionInjector *ActionInjector::instance = NULL;
+
+ActionInjector *ActionInjector::getInstance()
+{
+    if (ActionInjector::instance == NULL)
+        ActionInjector::instance = new ActionInjector();
+
+    return ActionInjector::instance;
+}
+
+Display *ActionInjector::display()
+{
+    if (ActionInjector::instance != NULL && ActionInjector::instance->privateDisplay != NULL)
+        return ActionInjector::instance->privateDisplay;
+
+    return XConnection::display();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+ActionInjector::ActionInjector()
+    : QThread(),
+      head(0),
+      tail(0),
+      sleeping(0),
+      wakeUp(0),
+      privateDisplay(NULL) {}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void ActionInjector::startInjector()
+{
+    if (this->privateDisplay != NULL)
+        return;
+
+    // The errors of the actions, for example a window closed before the action is executed, must not exit
+    XConnection::installErrorHandler();
+    this->privateDisplay = XOpenDisplay(NULL);
+    if (this->privateDisplay == NULL) {
+        qWarning() << "Error opening the connection to the X server of the actions, executing them synchronously";
+        return;
+    }
+
+    this->start();
+}
+
+void ActionInjector::stopInjector()
+{
+    if (this->privateDisplay == NULL)
+        return;
+
+    this->post(STOP, NULL);
+    this->wait();
+
+    XCloseDisplay(this->privateDisplay);
+    this->privateDisplay = NULL;
+}
+
+void ActionInjector::post(CommandType type, Action *action, const QHash<QString, QVariant>& attrs)
+{
+    Command command;
+    command.type    = type;
+    command.action  = action;
+    command.attrs   = attrs;
+    command.context = LatencyStats::getContext();
+
+    if (this->privateDisplay == NULL) {
+        this->execute(command);
+        return;
+    }
+
+    // Wait while the queue is full. The producer is the only writer of tail
+    int position = this->tail;
+    while (position - this->head.fetchAndAddAcquire(0) >= QUEUE_SIZE)
+        QThread::yieldCurrentThread();
+
+    this->queue[position & (QUEUE_SIZE - 1)] = command;
+    this->tail.fetchAndStoreRelease(position + 1);
+
+    if (this->sleeping.testAndSetOrdered(1, 0))
+        this->wakeUp.release();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                       PROTECTED METHODS                                      ********** //
+// ****************************************************************************************************************** //
+
+void ActionInjector::run()
+{
+    forever {
+        int position = this->head;
+
+        // Park until a command is posted. The queue is checked again after announcing it to avoid losing a wake up
+        if (position == this->tail.fetchAndAddAcquire(0)) {
+            this->sleeping.fetchAndStoreOrdered(1);
+            if (position != this->tail.fetchAndAddAcquire(0)) {
+                // If the producer has already reset the flag it has also released the semaphore
+                if (!this->sleeping.testAndSetOrdered(1, 0))
+                    this->wakeUp.acquire();
+            } else {
+                this->wakeUp.acquire();
+            }
+            continue;
+        }
+
+        Command &command = this->queue[position & (QUEUE_SIZE - 1)];
+        bool stop = (command.type == STOP);
+        if (!stop)
+            this->execute(command);
+
+        // Release the reference to the attributes before handing the slot back to the producer
+        command.attrs = QHash<QString, QVariant>();
+        this->head.fetchAndStoreRelease(position + 1);
+
+        if (stop)
+            return;
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void ActionInjector::execute(const Command &command) const
+{
+    bool async = (QThread::currentThread() == this);
+    if (async)
+        LatencyStats::beginInjection(command.context);
+
+    switch (command.type) {
+    case EXECUTE_START:
+        command.action->executeStart(command.attrs);
+        break;
+    case EXECUTE_UPDATE:
+        command.action->executeUpdate(command.attrs);
+        break;
+    case EXECUTE_FINISH:
+        command.action->executeFinish(command.attrs);
+        break;
+    case EXECUTE_CANCEL:
+        command.action->executeCancel();
+        break;
+    case DELETE_ACTION:
+        delete command.action;
+        break;
+    case STOP:
+        break;
+    }
+
+    if (async)
+        LatencyStats::endInjection();
+}
@@ -0,0 +1,170 @@
+/**
+ * @file /src/touchegg/actions/injector/ActionInjector.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  ActionInjector
+ */
+#ifndef ACTIONINJECTOR_H
+#define ACTIONINJECTOR_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/stats/LatencyStats.h"
+
+class Action;
+
+/**
+ * Thread that executes the actions with its own connection to the X server, so a slow request made by an action does
+ * not delay the processing of the GEIS events and the recognition of the gestures.
+ *
+ * The gestures post the parts of their actions to execute (and the actions to delete) through a bounded lock-free
+ * queue with a single producer, the main thread, and a single consumer, the injection thread. The injection thread
+ * parks on a semaphore when the queue is empty.
+ *
+ * If the thread is not running, for example in the benchmark, the commands are executed synchronously in the calling
+ * thread using the display of the application.
+ */
+class ActionInjector : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Commands that can be posted.
+     */
+    enum CommandType {
+        EXECUTE_START,
+        EXECUTE_UPDATE,
+        EXECUTE_FINISH,
+        EXECUTE_CANCEL,
+        DELETE_ACTION,
+        STOP
+    };
+
+    /**
+     * Returns the single instance of the class.
+     * @return The instance.
+     */
+    static ActionInjector *getInstance();
+
+    /**
+     * Returns the connection to the X server that the actions must use: the private connection of the injection thread
+     * if it is running or the connection of the application otherwise.
+     * @return The display.
+     */
+    static Display *display();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Opens the private connection to the X server and starts the injection thread. If the connection can't be opened
+     * the actions are executed synchronously.
+     */
+    void startInjector();
+
+    /**
+     * Executes the pending commands, stops the injection thread and closes its connection.
+     */
+    void stopInjector();
+
+    /**
+     * Posts a command for the indicated action. Must be called always from the same thread. Blocks while the queue is
+     * full.
+     * @param type   The command.
+     * @param action The action. After a DELETE_ACTION command it must not be used.
+     * @param attrs  Gesture attributes, used by the EXECUTE_* commands.
+     */
+    void post(CommandType type, Action *action,
+            const QHash<QString, QVariant>& attrs = QHash<QString, QVariant>());
+
+protected:
+
+    /**
+     * Executes the queued commands until a STOP command is received.
+     */
+    void run();
+
+private:
+
+    /**
+     * A queued command.
+     */
+    struct Command {
+        CommandType type;
+        Action *action;
+        QHash<QString, QVariant> attrs;
+        LatencyStats::Context context;
+    };
+
+    /**
+     * Executes a command.
+     * @param command The command.
+     */
+    void execute(const Command &command) const;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Size of the queue, must be a power of two.
+     */
+    static const int QUEUE_SIZE = 256;
+
+    /**
+     * The commands. The slot of a command is its sequence number modulo QUEUE_SIZE.
+     */
+    Command queue[QUEUE_SIZE];
+
+    /**
+     * Sequence number of the next command to execute, only written by the injection thread.
+     */
+    QAtomicInt head;
+
+    /**
+     * Sequence number of the next command to post, only written by the producer.
+     */
+    QAtomicInt tail;
+
+    /**
+     * 1 if the injection thread is parked, or about to park, in wakeUp.
+     */
+    QAtomicInt sleeping;
+
+    /**
+     * Semaphore on which the injection thread is parked when the queue is empty.
+     */
+    QSemaphore wakeUp;
+
+    /**
+     * Private connection to the X server or NULL if the thread is not running.
+     */
+    Display *privateDisplay;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static ActionInjector *instance;
+
+    // Hide constructors
+    ActionInjector();
+    ActionInjector(const ActionInjector &);
+    const ActionInjector &operator = (const ActionInjector &);
+
+};
+
+#endif // ACTIONINJECTOR_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/actions/injector/ActionInjector.h
+
+SOURCES += \
+    src/touchegg/actions/injector/ActionInjector.cpp
@@ -52,7 +52,9 @@ public:
         SEND_KEYS,
         MOVE_WINDOW,
         RUN_COMMAND,
-        DRAG_AND_DROP
+        DRAG_AND_DROP,
+        ZOOM,
+        ROTATE
     };
 
     /**
@@ -55,6 +55,12 @@ void Config::loadConfig()
     Config::getInstance();
 }
 
+void Config::loadConfig(const QString &fileName)
+{
+    delete instance;
+    instance = new Config(fileName);
+}
+
 
 // ****************************************************************************************************************** //
 // **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
@@ -62,7 +68,12 @@ void Config::loadConfig()
 
 Config::Config()
 {
-    this->composedGesturesTime = 0;
+    this->composedGesturesTime    = 0;
+    this->classificationThreshold = 2;
+    this->classificationTime      = 50;
+    this->numDirections           = 8;
+    this->gestureTimeout          = 3000;
+    this->speculativeTaps         = false;
     QFile homeFile(QDir::homePath() + HOME_CONFIG_FILE);
     QFile usrFile(USR_SHARE_CONFIG_FILE);
 
@@ -83,21 +94,28 @@ Config::Config()
     this->initConfig(homeFile);
 }
 
+Config::Config(const QString &fileName)
+{
+    this->composedGesturesTime    = 0;
+    this->classificationThreshold = 2;
+    this->classificationTime      = 50;
+    this->numDirections           = 8;
+    this->gestureTimeout          = 3000;
+    this->speculativeTaps         = false;
+    QFile file(fileName);
+    this->initConfig(file);
+}
+
 // ****************************************************************************************************************** //
 // **********                                        PRIVATE METHODS                                       ********** //
 // ****************************************************************************************************************** //
 
 void Config::initConfig(QFile &file)
 {
-    // Loads the XML file
-    QDomDocument document;
-    if (!file.open(QIODevice::ReadOnly))
-        qFatal("Can't open configuration file for read");
-    if (!document.setContent(&file)) {
-        file.close();
-        qFatal("Error reading configuration, please, review the format");
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Can't open configuration file for read:" << file.fileName();
+        return;
     }
-    file.close();
 
     /*
      * A very simple example of a configuration file:
@@ -105,8 +123,17 @@ void Config::initConfig(QFile &file)
      *
      *     <settings>
      *         <property name="composed_gestures_time">140</property>
+     *         <property name="classification_threshold">2</property>
+     *         <property name="classification_time">50</property>
+     *         <property name="directions">8</property>
+     *         <property name="gesture_timeout">3000</property>
+     *         <property name="speculative_taps">false</property>
      *     </settings>
      *
+     *     <device name="Touchpad">
+     *         <property name="gain">1.5</property>
+     *     </device>
+     *
      *     <application name="All">
      *
      *         <gesture type="tap" fingers="5" direction="">
@@ -129,119 +156,198 @@ void Config::initConfig(QFile &file)
      *             </action>
      *         </gesture>
      *
+     *         <!-- Control + mouse wheel every 10% of change in the distance between the fingers -->
+     *         <gesture type="pinch" fingers="4" direction="all">
+     *             <action type="ZOOM">STEP=10:RATE=20</action>
+     *         </gesture>
+     *
+     *         <!-- A key combination every 15 degrees -->
+     *         <gesture type="rotate" fingers="2" direction="all">
+     *             <action type="ROTATE">STEP=15:LEFT=Control+L:RIGHT=Control+R</action>
+     *         </gesture>
+     *
+     *         <!-- Every 20 millimetres, at most 4 times per second -->
+     *         <gesture type="drag" fingers="3" direction="down">
+     *             <action type="SEND_KEYS" when="AT_UPDATE" step="20" rate="4">
+     *                 Control+Next
+     *             </action>
+     *         </gesture>
+     *
+     *     </application>
+     *
+     *     <application name="All" device="Touchscreen">
+     *
+     *         <gesture type="drag" fingers="1" direction="all">
+     *             <action type="DRAG_AND_DROP"></action>
+     *         </gesture>
+     *
+     *     </application>
+     *
+     *     <!-- The name of the monitor as reported by XRandR, usually the name of its output -->
+     *     <application name="All" monitor="HDMI-1">
+     *
+     *         <gesture type="drag" fingers="4" direction="up">
+     *             <action type="SHOW_DESKTOP"></action>
+     *         </gesture>
+     *
      *     </application>
      *
      * </touchégg>
      */
 
-    for (QDomNode appNode=document.documentElement().firstChild(); !appNode.isNull(); appNode=appNode.nextSibling()) {
-        QDomElement appElem = appNode.toElement();
-        if (appElem.isNull())
-            continue;
-
-        // Load general Touchégg settings
-        if (appElem.tagName() == "settings") {
-
-            for (QDomNode propNode = appNode.firstChild(); !propNode.isNull(); propNode = propNode.nextSibling()) {
-                if (!propNode.toElement().isNull()
-                        && propNode.toElement().attribute("name") == "composed_gestures_time") {
-                    this->composedGesturesTime = propNode.toElement().text().toInt();
+    QXmlStreamReader xml(&file);
+
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+
+            // Load general Touchégg settings
+            if (xml.name() == QLatin1String("settings")) {
+                while (xml.readNextStartElement()) {
+                    QString name = xml.attributes().value("name").toString();
+                    if (name == QLatin1String("composed_gestures_time"))
+                        this->composedGesturesTime = xml.readElementText().toInt();
+                    else if (name == QLatin1String("classification_threshold"))
+                        this->classificationThreshold = xml.readElementText().toFloat();
+                    else if (name == QLatin1String("classification_time"))
+                        this->classificationTime = xml.readElementText().toInt();
+                    else if (name == QLatin1String("directions"))
+                        this->numDirections = (xml.readElementText().toInt() == 4) ? 4 : 8;
+                    else if (name == QLatin1String("gesture_timeout"))
+                        this->gestureTimeout = qMax(0, xml.readElementText().toInt());
+                    else if (name == QLatin1String("speculative_taps"))
+                        this->speculativeTaps = (xml.readElementText().trimmed() == QLatin1String("true"));
+                    else
+                        xml.skipCurrentElement();
                 }
+
+            // Load touch devices settings
+            } else if (xml.name() == QLatin1String("device")) {
+                this->readDevice(xml);
+
+            // Load applications/gestures settings. The name can be a comma separated list of applications, and the
+            // gestures can be restricted to the devices of a <device> and to a monitor
+            } else {
+                QStringList apps = xml.attributes().value("name").toString().split(",");
+                for (int n = 0; n < apps.length(); n++)
+                    apps[n] = apps.at(n).trimmed();
+                QString device  = xml.attributes().value("device").toString().trimmed();
+                QString monitor = xml.attributes().value("monitor").toString().trimmed();
+
+                while (xml.readNextStartElement())
+                    this->readGesture(xml, apps, device, monitor);
             }
+        }
+    }
 
-        } else {
-            // Load applications/gestures settings
-            for (QDomNode gestureNode = appNode.firstChild(); !gestureNode.isNull();
-                    gestureNode = gestureNode.nextSibling()) {
-                QDomElement gestureElem = gestureNode.toElement();
-                if (gestureElem.isNull())
-                    continue;
-
-                // For common configuration applications
-                QStringList apps = appElem.attribute("name").split(",");
-                QStringList keys;
-
-                for (int n = 0; n < apps.length(); n++) {
-                    QString appName = apps.at(n).trimmed();
-                    QString key = appName + "."
-                            + gestureElem.attribute("type") + "."
-                            + gestureElem.attribute("fingers") + "."
-                            + gestureElem.attribute("direction");
-                    if (key.right(1) == ".")   // For the tap gestures,
-                        key += "NO_DIRECTION"; // without direction
-                    keys.append(key);
-                }
+    if (xml.hasError()) {
+        qWarning("Error reading configuration at line %lld, column %lld: %s", xml.lineNumber(), xml.columnNumber(),
+                qPrintable(xml.errorString()));
+        this->actions.clear();
+        this->usedGestures.clear();
+        this->composedGestures.clear();
+    }
 
-                // Get the action
-                QString action, timing;
-                for (QDomNode actNode = gestureNode.firstChild(); !actNode.isNull(); actNode = actNode.nextSibling()) {
-                    if (!actNode.toElement().isNull()) {
-                        action = actNode.toElement().attribute("type");
-                        timing = actNode.toElement().attribute("when");
-                        // By default, perform the action at the end. 
-                        if (timing != "AT_START" && timing != "AT_END") {
-                            timing = "AT_END";
-                        }
-                    }
-                }                
-
-                // Get the settings
-                QString settings;
-                for (QDomNode settNode=gestureNode.firstChild(); !settNode.isNull(); settNode=settNode.nextSibling()) {
-                    if (!settNode.toElement().isNull())
-                        settings = settNode.toElement().text();
-                }
+    file.close();
+}
 
-                // Save the actions and the settings into the settings QHash
-                for (int n = 0; n < keys.length(); n++) {
-                    this->settings.insert(keys.at(n) + ".action", action);
-                    this->settings.insert(keys.at(n) + ".settings", settings);
-                    this->settings.insert(keys.at(n) + ".timing", timing);
-                }
+void Config::readGesture(QXmlStreamReader &xml, const QStringList &apps, const QString &device,
+        const QString &monitor)
+{
+    QXmlStreamAttributes gestureAttrs = xml.attributes();
+    QString type      = gestureAttrs.value("type").toString();
+    QString direction = gestureAttrs.value("direction").toString();
+    int fingers       = gestureAttrs.value("fingers").toString().toInt();
+
+    // Get the action and its settings. By default, perform the action at the end
+    ActionConfig actionConfig;
+    actionConfig.type = ActionTypeEnum::NO_ACTION;
+    actionConfig.timing = "AT_END";
+    actionConfig.step = 20;
+    actionConfig.rate = 4;
+    QString action;
+
+    while (xml.readNextStartElement()) {
+        QXmlStreamAttributes attrs = xml.attributes();
+        action = attrs.value("type").toString();
+        actionConfig.type = ActionTypeEnum::getEnum(action);
+        if (attrs.value("when") == QLatin1String("AT_START"))
+            actionConfig.timing = "AT_START";
+        else if (attrs.value("when") == QLatin1String("AT_UPDATE"))
+            actionConfig.timing = "AT_UPDATE";
+        if (attrs.hasAttribute("step"))
+            actionConfig.step = attrs.value("step").toString().toFloat();
+        if (attrs.hasAttribute("rate"))
+            actionConfig.rate = attrs.value("rate").toString().toFloat();
+        actionConfig.settings = xml.readElementText();
+    }
 
-                //--------------------------------------------------------------
+    if (xml.hasError())
+        return;
 
-                // If is an used gesture add it to the usedGestures QHash
-                if (action != "" && action != "NO_ACTION") {
-                    for (int n = 0; n < apps.length(); n++) {
-                        QString app = apps.at(n).trimmed();
-                        QString gesture = gestureElem.attribute("type");
-                        int fingers = gestureElem.attribute("fingers").toInt();
+    GestureTypeEnum::GestureType gestureType = GestureTypeEnum::getEnum(type);
+    GestureDirectionEnum::GestureDirection gestureDir = direction.isEmpty()  // For the tap gestures, without direction
+            ? GestureDirectionEnum::NO_DIRECTION
+            : GestureDirectionEnum::getEnum(direction);
 
-                        this->saveUsedGestures(app, gesture, fingers);
-                    }
-                }
-            }
+    if ((int)gestureType == -1 || (int)gestureDir == -1 || (int)actionConfig.type == -1) {
+        qWarning("Ignoring unknown gesture %s %s %s at line %lld", qPrintable(type), qPrintable(direction),
+                qPrintable(action), xml.lineNumber());
+        return;
+    }
 
+    // Save the action into the actions QHash and, if is an used gesture, add it to the usedGestures QHash and to the
+    // composedGestures QHash
+    int key = Config::gestureKey(gestureType, fingers, gestureDir);
+    bool isComposed = gestureType == GestureTypeEnum::DOUBLE_TAP || gestureType == GestureTypeEnum::TRIPLE_TAP
+            || gestureType == GestureTypeEnum::TAP_AND_HOLD;
+    foreach (const QString &app, apps) {
+        this->actions[Config::appKey(app, device, monitor)].insert(key, actionConfig);
+
+        if (actionConfig.type != ActionTypeEnum::NO_ACTION) {
+            this->saveUsedGestures(app, type, fingers);
+            if (isComposed)
+                this->composedGestures[app][fingers] |= 1 << gestureType;
         }
     }
 }
 
-void Config::saveUsedGestures(const QString &app, const QString &gestureType, int numFingers)
+void Config::readDevice(QXmlStreamReader &xml)
 {
+    DeviceConfig deviceConfig;
+    deviceConfig.name = xml.attributes().value("name").toString().trimmed();
+    deviceConfig.gain = 1;
+
+    while (xml.readNextStartElement()) {
+        QString name = xml.attributes().value("name").toString();
+        if (name == QLatin1String("gain"))
+            deviceConfig.gain = xml.readElementText().toFloat();
+        else
+            xml.skipCurrentElement();
+    }
 
-    if (this->usedGestures.contains(app)) {
-        QList< QPair<QStringList, int> > aux = this->usedGestures.value(app);
-        QStringList gestures = GestureTypeEnum::getGeisEquivalent(GestureTypeEnum::getEnum(gestureType));
-
-        QPair<QStringList, int> pair;
-        pair.first = gestures;
-        pair.second = numFingers;
+    if (!deviceConfig.name.isEmpty() && deviceConfig.gain > 0)
+        this->devices.append(deviceConfig);
+}
 
-        aux.append(pair);
-        this->usedGestures.insert(app, aux);
+QString Config::appKey(const QString &app, const QString &device, const QString &monitor)
+{
+    QString key = device.isEmpty() ? app : app + '@' + device;
+    return monitor.isEmpty() ? key : key + '#' + monitor;
+}
 
-    } else {
-        QList< QPair<QStringList, int> > aux;
-        QStringList gestures = GestureTypeEnum::getGeisEquivalent(GestureTypeEnum::getEnum(gestureType));
+int Config::gestureKey(GestureTypeEnum::GestureType gestureType, int numFingers,
+        GestureDirectionEnum::GestureDirection dir)
+{
+    return (gestureType << 16) | ((numFingers & 0xFF) << 8) | dir;
+}
 
-        QPair<QStringList, int> pair;
-        pair.first = gestures;
-        pair.second = numFingers;
+void Config::saveUsedGestures(const QString &app, const QString &gestureType, int numFingers)
+{
+    QPair<QStringList, int> pair;
+    pair.first = GestureTypeEnum::getGeisEquivalent(GestureTypeEnum::getEnum(gestureType));
+    pair.second = numFingers;
 
-        aux.append(pair);
-        this->usedGestures.insert(app, aux);
-    }
+    this->usedGestures[app].append(pair);
 }
 
 
@@ -263,99 +369,95 @@ int Config::getComposedGesturesTime() const
     return this->composedGesturesTime;
 }
 
-//------------------------------------------------------------------------------
+float Config::getClassificationThreshold() const
+{
+    return this->classificationThreshold;
+}
 
-ActionTypeEnum::ActionType Config::getAssociatedAction(const QString &appClass,
-        GestureTypeEnum::GestureType gestureType, int numFingers,
-        GestureDirectionEnum::GestureDirection dir) const
+int Config::getClassificationTime() const
 {
-    QString exactKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".action";
-    QString allDirectionsKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.action";
-    QString globalExactKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".action";
-    QString globalAllDirectionsKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.action";
-
-    if (this->settings.contains(exactKey))
-        return ActionTypeEnum::getEnum(this->settings.value(exactKey));
-    else if (this->settings.contains(allDirectionsKey))
-        return ActionTypeEnum::getEnum(this->settings.value(allDirectionsKey));
-    else if (this->settings.contains(globalExactKey))
-        return ActionTypeEnum::getEnum(this->settings.value(globalExactKey));
-    else if (this->settings.contains(globalAllDirectionsKey))
-        return ActionTypeEnum::getEnum(this->settings.value(
-                globalAllDirectionsKey));
-    else
-        return ActionTypeEnum::NO_ACTION;
+    return this->classificationTime;
 }
 
-QString Config::getAssociatedSettings(const QString &appClass,
-        GestureTypeEnum::GestureType gestureType, int numFingers,
-        GestureDirectionEnum::GestureDirection dir) const
+int Config::getNumDirections() const
+{
+    return this->numDirections;
+}
+
+int Config::getGestureTimeout() const
 {
-    QString exactKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".settings";
-    QString allDirectionsKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.settings";
-    QString globalExactKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".settings";
-    QString globalAllDirectionsKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.settings";
-
-    if (this->settings.contains(exactKey))
-        return this->settings.value(exactKey);
-    else if (this->settings.contains(allDirectionsKey))
-        return this->settings.value(allDirectionsKey);
-    else if (this->settings.contains(globalExactKey))
-        return this->settings.value(globalExactKey);
-    else if (this->settings.contains(globalAllDirectionsKey))
-        return this->settings.value(globalAllDirectionsKey);
-    else
-        return "";
+    return this->gestureTimeout;
 }
 
+bool Config::isSpeculativeTapsEnabled() const
+{
+    return this->speculativeTaps;
+}
+
+//------------------------------------------------------------------------------
 
-QString Config::getAssociatedTiming(const QString &appClass,
+const ActionConfig *Config::getAssociatedConfig(const QString &appClass,
         GestureTypeEnum::GestureType gestureType, int numFingers,
-        GestureDirectionEnum::GestureDirection dir) const
+        GestureDirectionEnum::GestureDirection dir,
+        GestureDirectionEnum::GestureDirection fallbackDir, const QString &device, const QString &monitor) const
+{
+    // Keys in priority order: exact direction, fallback direction (the axis of a diagonal) and all directions
+    int keys[3];
+    int numKeys = 0;
+    keys[numKeys++] = Config::gestureKey(gestureType, numFingers, dir);
+    if (fallbackDir != dir && fallbackDir != GestureDirectionEnum::NO_DIRECTION)
+        keys[numKeys++] = Config::gestureKey(gestureType, numFingers, fallbackDir);
+    keys[numKeys++] = Config::gestureKey(gestureType, numFingers, GestureDirectionEnum::ALL);
+
+    // Applications in priority order, the configuration of the device is only looked up if the device has settings
+    // and the configuration of the monitor if the monitor is known
+    QString apps[8];
+    int numApps = 0;
+    QString appNames[2] = { appClass, "All" };
+    for (int a = 0; a < 2; a++) {
+        if (!device.isEmpty() && !monitor.isEmpty())
+            apps[numApps++] = Config::appKey(appNames[a], device, monitor);
+        if (!device.isEmpty())
+            apps[numApps++] = Config::appKey(appNames[a], device, QString());
+        if (!monitor.isEmpty())
+            apps[numApps++] = Config::appKey(appNames[a], QString(), monitor);
+        apps[numApps++] = appNames[a];
+    }
+
+    for (int n = 0; n < numApps; n++) {
+        QHash<QString, QHash<int, ActionConfig> >::const_iterator app = this->actions.constFind(apps[n]);
+        if (app == this->actions.constEnd())
+            continue;
+
+        for (int k = 0; k < numKeys; k++) {
+            QHash<int, ActionConfig>::const_iterator it = app->constFind(keys[k]);
+            if (it != app->constEnd())
+                return &it.value();
+        }
+    }
+
+    return NULL;
+}
+
+bool Config::hasComposedGestures(const QString &appClass, int numFingers, int numTaps) const
 {
-    QString exactKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".timing";
-    QString allDirectionsKey = appClass + "."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.timing";
-    QString globalExactKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + "."
-            + GestureDirectionEnum::getValue(dir) + ".timing";
-    QString globalAllDirectionsKey = "All."
-            + GestureTypeEnum::getValue(gestureType) + "."
-            + QString::number(numFingers) + ".ALL.timing";
-
-    if (this->settings.contains(exactKey))
-        return this->settings.value(exactKey);
-    else if (this->settings.contains(allDirectionsKey))
-        return this->settings.value(allDirectionsKey);
-    else if (this->settings.contains(globalExactKey))
-        return this->settings.value(globalExactKey);
-    else if (this->settings.contains(globalAllDirectionsKey))
-        return this->settings.value(globalAllDirectionsKey);
-    else
-        return "AT_END";
+    int mask = 0;
+    if (numTaps == 1)
+        mask = (1 << GestureTypeEnum::DOUBLE_TAP) | (1 << GestureTypeEnum::TRIPLE_TAP)
+                | (1 << GestureTypeEnum::TAP_AND_HOLD);
+    else if (numTaps == 2)
+        mask = 1 << GestureTypeEnum::TRIPLE_TAP;
+
+    return (this->composedGestures.value(appClass).value(numFingers) & mask) != 0
+            || (this->composedGestures.value("All").value(numFingers) & mask) != 0;
+}
+
+const DeviceConfig *Config::getDeviceConfig(const QString &deviceName) const
+{
+    for (int n = 0; n < this->devices.length(); n++) {
+        if (deviceName.contains(this->devices.at(n).name, Qt::CaseInsensitive))
+            return &this->devices.at(n);
+    }
+
+    return NULL;
 }
@@ -26,6 +26,47 @@
 #include "src/touchegg/gestures/types/GestureDirectionEnum.h"
 #include "src/touchegg/actions/types/ActionTypeEnum.h"
 
+/**
+ * Action associated to a gesture, as it is read from the configuration file.
+ */
+struct ActionConfig {
+    /**
+     * Action type.
+     */
+    ActionTypeEnum::ActionType type;
+
+    /**
+     * Action settings.
+     */
+    QString settings;
+
+    /**
+     * Timing information, either "AT_START", "AT_UPDATE" or "AT_END".
+     */
+    QString timing;
+
+    /**
+     * With "AT_UPDATE", displacement between two executions and maximum number of executions per second.
+     */
+    float step;
+    float rate;
+};
+
+/**
+ * Settings of the touch devices whose name contains the indicated one, as they are read from the configuration file.
+ */
+struct DeviceConfig {
+    /**
+     * Part of the name of the devices, compared without case.
+     */
+    QString name;
+
+    /**
+     * Factor applied to the displacement of the drags.
+     */
+    float gain;
+};
+
 /**
  * Singleton that provides access to the configuration.
  */
@@ -45,6 +86,12 @@ public:
      */
     static void loadConfig();
 
+    /**
+     * (Re)Load configuration from the specified file instead of the user configuration file.
+     * @param fileName The file.
+     */
+    static void loadConfig(const QString &fileName);
+
     //------------------------------------------------------------------------------------------------------------------
 
     /**
@@ -64,56 +111,122 @@ public:
      */
     int getComposedGesturesTime() const;
 
-    //------------------------------------------------------------------------------------------------------------------
+    /**
+     * Returns the displacement, in millimetres, needed to classify the direction of a gesture.
+     * @return The threshold.
+     * @see GestureClassifier
+     */
+    float getClassificationThreshold() const;
 
     /**
-     * Returns the associated action type with a gesture.
-     * @param  appClass Application where it is made ​​the gesture.
-     * @param  gestureType The gesture that is made.
-     * @param  numFingers Number of fingers used by the gesture.
-     * @param  dir Direction of the gesture.
-     * @return Type of associated action.
+     * Returns the maximum time, in milliseconds, to classify the direction of a gesture.
+     * @return The time.
+     * @see GestureClassifier
      */
-    ActionTypeEnum::ActionType getAssociatedAction(const QString &appClass,
-            GestureTypeEnum::GestureType gestureType, int numFingers,
-            GestureDirectionEnum::GestureDirection dir) const;
+    int getClassificationTime() const;
 
     /**
-     * Returns the associated config with the indicated gesture.
-     * @param  appClass Application where it is made ​​the gesture.
-     * @param  gestureType The gesture that is made.
-     * @param  numFingers Number of fingers used by the gesture.
-     * @param  dir Direction of the gesture.
-     * @return The settings.
+     * Returns the number of directions of the drags and tap & holds: 4 or 8, with the diagonals.
+     * @return The number of directions.
+     */
+    int getNumDirections() const;
+
+    /**
+     * Returns the time, in milliseconds, without frames after which a gesture that has not finished is cancelled.
+     * @return The time, 0 if the gestures are never cancelled.
      */
-    QString getAssociatedSettings(const QString &appClass,
-            GestureTypeEnum::GestureType gestureType, int numFingers,
-            GestureDirectionEnum::GestureDirection dir) const;
+    int getGestureTimeout() const;
 
     /**
-     * Returns the associated timing information for the action 
-     * with the indicated gesture.
-     * @param  appClass Application where it is made ​​the gesture.
+     * Returns if the taps whose action can run speculatively, see Action::canRunSpeculatively(), are executed as soon
+     * as they are made, even if they can be the start of a composed gesture.
+     * @return If the speculative execution is enabled.
+     */
+    bool isSpeculativeTapsEnabled() const;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Returns the action associated with a gesture. The application specific configuration has priority over the
+     * global ("All") one, the configuration of the device over the configuration for every device, the configuration
+     * of the monitor over the configuration for every monitor, and the exact direction has priority over the fallback
+     * direction and the "ALL" direction.
+     * @param  appClass Application where it is made the gesture.
      * @param  gestureType The gesture that is made.
      * @param  numFingers Number of fingers used by the gesture.
      * @param  dir Direction of the gesture.
-     * @return The timing information, either "AT_START" or "AT_END".
+     * @param  fallbackDir Direction used if dir has no action, for example, the axis nearest to a diagonal.
+     * @param  device Name of the device settings that match the device of the gesture, empty if none.
+     * @param  monitor Name of the monitor where the gesture is made, empty if unknown.
+     * @return The action or NULL if the gesture has no associated action.
      */
-    QString getAssociatedTiming(const QString &appClass,
-            GestureTypeEnum::GestureType gestureType, int numFingers,
-            GestureDirectionEnum::GestureDirection dir) const;
+    const ActionConfig *getAssociatedConfig(const QString &appClass, GestureTypeEnum::GestureType gestureType,
+            int numFingers, GestureDirectionEnum::GestureDirection dir,
+            GestureDirectionEnum::GestureDirection fallbackDir = GestureDirectionEnum::NO_DIRECTION,
+            const QString &device = QString(), const QString &monitor = QString()) const;
 
+    /**
+     * Returns if a sequence of taps can continue as a composed gesture with an action: a DOUBLE_TAP, a TRIPLE_TAP or a
+     * TAP_AND_HOLD after one tap, a TRIPLE_TAP after two. If it can't the taps don't need to wait for the next one.
+     * @param  appClass   Application where it is made the gesture.
+     * @param  numFingers Number of fingers of the taps.
+     * @param  numTaps    Number of taps of the sequence.
+     * @return If the sequence can continue.
+     */
+    bool hasComposedGestures(const QString &appClass, int numFingers, int numTaps) const;
+
+    /**
+     * Returns the settings of a touch device: the first <device> whose name is contained in the name of the device.
+     * @param  deviceName Name of the device, as reported by GEIS.
+     * @return The settings or NULL if there are no settings for the device.
+     */
+    const DeviceConfig *getDeviceConfig(const QString &deviceName) const;
 
 private:
 
     /**
-     * Initializes the QHash's for the configuration and used gestures.
+     * Initializes the QHash's for the configuration and used gestures reading the file in a single pass. If the file
+     * is malformed the error is reported with its line and column and the configuration is left empty.
      * @param file File from which to read configuration.
-     * @see settings
+     * @see actions
      * @see usedGestures
      */
     void initConfig(QFile &file);
 
+    /**
+     * Reads a <gesture> element and saves its action for all the indicated applications.
+     * @param xml    Reader positioned at the start of the <gesture> element.
+     * @param apps   Applications that share the gesture.
+     * @param device Name of the device settings the gesture is restricted to, empty for all the devices.
+     * @param monitor Name of the monitor the gesture is restricted to, empty for all the monitors.
+     */
+    void readGesture(QXmlStreamReader &xml, const QStringList &apps, const QString &device, const QString &monitor);
+
+    /**
+     * Reads a <device> element and saves its settings.
+     * @param xml Reader positioned at the start of the <device> element.
+     */
+    void readDevice(QXmlStreamReader &xml);
+
+    /**
+     * Returns the key used to store the actions of an application in the actions QHash.
+     * @param  app    The application.
+     * @param  device Name of the device settings, empty for all the devices.
+     * @param  monitor Name of the monitor, empty for all the monitors.
+     * @return The key.
+     */
+    static QString appKey(const QString &app, const QString &device, const QString &monitor);
+
+    /**
+     * Returns the key used to store a gesture in the actions QHash.
+     * @param  gestureType The gesture.
+     * @param  numFingers  Number of fingers.
+     * @param  dir         Direction of the gesture.
+     * @return The key.
+     */
+    static int gestureKey(GestureTypeEnum::GestureType gestureType, int numFingers,
+            GestureDirectionEnum::GestureDirection dir);
+
     /**
      * Saves the used gestures in the list.
      * @param app The application.
@@ -130,10 +243,31 @@ private:
     int composedGesturesTime;
 
     /**
-     * QHash with the configuration. The keys are like Application.GestureType.NumFingers.Direction.action/settings and
-     * the value is the action or the settings associate to the gesture.
+     * Displacement and time of the classification window.
+     */
+    float classificationThreshold;
+    int classificationTime;
+
+    /**
+     * Number of directions, 4 or 8.
+     */
+    int numDirections;
+
+    /**
+     * Time without frames to cancel a gesture.
+     */
+    int gestureTimeout;
+
+    /**
+     * Execute the taps that can run speculatively without waiting for the composed gestures.
      */
-    QHash<QString, QString> settings;
+    bool speculativeTaps;
+
+    /**
+     * QHash with the configuration. The key is the application, see appKey(), and the value a QHash with the actions of
+     * the application, indexed by gestureKey().
+     */
+    QHash<QString, QHash<int, ActionConfig> > actions;
 
     /**
      * QHash with the gestures used by Touchégg, being the key the application and the value the gestures.
@@ -141,6 +275,17 @@ private:
      */
     QHash<QString, QList< QPair<QStringList, int> > > usedGestures;
 
+    /**
+     * QHash with the composed gestures with action, being the key the application and the value a QHash whose key is
+     * the number of fingers and the value a mask with a bit (1 << type) for each composed GestureType.
+     */
+    QHash<QString, QHash<int, int> > composedGestures;
+
+    /**
+     * Settings of the touch devices, in the order of the file.
+     */
+    QList<DeviceConfig> devices;
+
     //------------------------------------------------------------------------------------------------------------------
 
     /**
@@ -150,6 +295,7 @@ private:
 
     // Hide constructors
     Config();
+    Config(const QString &fileName);
     Config(const Config &);
     const Config &operator = (const Config &);
 
@@ -0,0 +1,102 @@
+/**
+ * @file /src/touchegg/devices/DeviceTable.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  DeviceTable
+ */
+#include "DeviceTable.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+DeviceTable *DeviceTable::instance = NULL;
+
+DeviceTable *DeviceTable::getInstance()
+{
+    if (DeviceTable::instance == NULL)
+        DeviceTable::instance = new DeviceTable();
+
+    return DeviceTable::instance;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void DeviceTable::addDevice(const DeviceInfo &device)
+{
+    DeviceInfo info = device;
+    info.mmPerUnitX = (!device.direct && device.resolutionX > 0) ? 1 / device.resolutionX : 0;
+    info.mmPerUnitY = (!device.direct && device.resolutionY > 0) ? 1 / device.resolutionY : 0;
+    const DeviceConfig *deviceConfig = Config::getInstance()->getDeviceConfig(device.name);
+    info.profile = (deviceConfig != NULL) ? deviceConfig->name : QString();
+    info.gain    = (deviceConfig != NULL) ? deviceConfig->gain : 1;
+
+    this->devices.insert(info.id, info);
+
+    qDebug() << "[+] New device:";
+    qDebug() << "\tName      -> " << info.name;
+    qDebug() << "\tID        -> " << info.id;
+    qDebug() << "\tTouches   -> " << info.touches;
+    qDebug() << "\tDirect    -> " << info.direct;
+    qDebug() << "\tProfile   -> " << info.profile;
+    qDebug() << "\tGain      -> " << info.gain;
+}
+
+void DeviceTable::removeDevice(int id)
+{
+    this->devices.remove(id);
+}
+
+const DeviceInfo *DeviceTable::getDevice(int id) const
+{
+    QHash<int, DeviceInfo>::const_iterator it = this->devices.constFind(id);
+    return (it != this->devices.constEnd()) ? &it.value() : NULL;
+}
+
+QList<int> DeviceTable::getDeviceIds() const
+{
+    return this->devices.keys();
+}
+
+void DeviceTable::normalizeDeltas(QHash<QString, QVariant> &attrs) const
+{
+    const DeviceInfo *device = this->getDevice(attrs.value(GEIS_GESTURE_ATTRIBUTE_DEVICE_ID).toInt());
+    float mmPerUnitX = (device != NULL) ? device->mmPerUnitX : 0;
+    float mmPerUnitY = (device != NULL) ? device->mmPerUnitY : 0;
+
+    // The pixels are converted with the monitor that Action::setMonitor() uses to convert them back
+    if (mmPerUnitX == 0 || mmPerUnitY == 0) {
+        MonitorCache *monitors = MonitorCache::getInstance();
+        float mmPerPixel = 1 / monitors->getPixelsPerMm(monitors->getGestureMonitor(attrs,
+                device != NULL && device->direct));
+        if (mmPerUnitX == 0)
+            mmPerUnitX = mmPerPixel;
+        if (mmPerUnitY == 0)
+            mmPerUnitY = mmPerPixel;
+    }
+
+    QHash<QString, QVariant>::iterator it = attrs.find(GEIS_GESTURE_ATTRIBUTE_DELTA_X);
+    if (it != attrs.end())
+        it.value() = it.value().toFloat() * mmPerUnitX;
+
+    it = attrs.find(GEIS_GESTURE_ATTRIBUTE_DELTA_Y);
+    if (it != attrs.end())
+        it.value() = it.value().toFloat() * mmPerUnitY;
+}
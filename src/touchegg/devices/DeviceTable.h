@@ -0,0 +1,147 @@
+/**
+ * @file /src/touchegg/devices/DeviceTable.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  DeviceTable
+ */
+#ifndef DEVICETABLE_H
+#define DEVICETABLE_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/config/Config.h"
+#include "src/touchegg/monitors/MonitorCache.h"
+
+/**
+ * A touch device, as reported by GEIS, with its settings already resolved.
+ */
+struct DeviceInfo {
+    /**
+     * GEIS ID and name of the device.
+     */
+    int id;
+    QString name;
+
+    /**
+     * Maximum number of touches.
+     */
+    int touches;
+
+    /**
+     * If it is a touchscreen (direct) or a touchpad (indirect).
+     */
+    bool direct;
+
+    /**
+     * Range of the axes, in device units, and their resolution, in units per millimetre (0 if unknown).
+     */
+    float minX;
+    float maxX;
+    float minY;
+    float maxY;
+    float resolutionX;
+    float resolutionY;
+
+    /**
+     * Millimetres of a unit of the deltas of the gestures of the touchpads, that are in device units. 0 for the
+     * touchscreens and the devices without resolution, whose deltas are in screen pixels.
+     */
+    float mmPerUnitX;
+    float mmPerUnitY;
+
+    /**
+     * Name of the <device> settings that match the device, empty if none.
+     */
+    QString profile;
+
+    /**
+     * Factor applied to the displacement of the drags.
+     */
+    float gain;
+};
+
+/**
+ * Table of the available touch devices, filled with the device events of GEIS. The settings of each device are looked
+ * up in the configuration once, when the device is added, so the gestures only need the ID of their device.
+ */
+class DeviceTable
+{
+
+public:
+
+    /**
+     * Only method to get an instance of the class.
+     * @return The single instance of the class.
+     */
+    static DeviceTable *getInstance();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Adds or replaces a device, resolving its settings.
+     * @param device The device. The millimetres per unit, the profile and the gain are overwritten.
+     */
+    void addDevice(const DeviceInfo &device);
+
+    /**
+     * Removes a device.
+     * @param id ID of the device.
+     */
+    void removeDevice(int id);
+
+    /**
+     * Returns a device.
+     * @param  id ID of the device.
+     * @return The device or NULL if it is not available.
+     */
+    const DeviceInfo *getDevice(int id) const;
+
+    /**
+     * Returns the IDs of the available devices.
+     * @return The IDs.
+     */
+    QList<int> getDeviceIds() const;
+
+    /**
+     * Converts the deltas of a frame to millimetres, so the actions behave the same with every device: with the
+     * resolution of the device of the frame or, if its deltas are in pixels, with the pixel density of the monitor
+     * where the gesture is made.
+     * @param attrs Gesture attributes of the frame.
+     */
+    void normalizeDeltas(QHash<QString, QVariant> &attrs) const;
+
+private:
+
+    /**
+     * The devices, being the key their ID.
+     */
+    QHash<int, DeviceInfo> devices;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static DeviceTable *instance;
+
+    // Hide constructors
+    DeviceTable() {}
+    DeviceTable(const DeviceTable &);
+    const DeviceTable &operator = (const DeviceTable &);
+
+};
+
+#endif // DEVICETABLE_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/devices/DeviceTable.h
+
+SOURCES += \
+    src/touchegg/devices/DeviceTable.cpp
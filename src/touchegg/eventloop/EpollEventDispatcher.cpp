@@ -0,0 +1,409 @@
+/**
+ * @file /src/touchegg/eventloop/EpollEventDispatcher.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  EpollEventDispatcher
+ */
+#include "EpollEventDispatcher.h"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <signal.h>
+#include <unistd.h>
+
+// Number of posted events pending in all the threads, exported by QtCore
+Q_CORE_EXPORT uint qGlobalPostedEventsCount();
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    /**
+     * Maximum number of file descriptors read by each epoll_wait().
+     */
+    const int MAX_EVENTS = 32;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+void EpollEventDispatcher::setSocketPriority(int fd, SocketPriority priority)
+{
+    EpollEventDispatcher *dispatcher = qobject_cast<EpollEventDispatcher *>(QAbstractEventDispatcher::instance());
+    if (dispatcher != NULL)
+        dispatcher->priorities.insert(fd, priority);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+EpollEventDispatcher::EpollEventDispatcher(QObject *parent)
+    : QAbstractEventDispatcher(parent),
+      signalFd(-1),
+      interrupted(0)
+{
+    this->epollFd  = epoll_create1(EPOLL_CLOEXEC);
+    this->wakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->epollFd == -1 || this->wakeUpFd == -1)
+        qFatal("Couldn't create the epoll event dispatcher");
+
+    struct epoll_event event;
+    event.events   = EPOLLIN;
+    event.data.u64 = WAKEUP_TAG;
+    epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->wakeUpFd, &event);
+}
+
+EpollEventDispatcher::~EpollEventDispatcher()
+{
+    foreach (const Timer &timer, this->timers) {
+        if (timer.fd != -1)
+            ::close(timer.fd);
+    }
+
+    if (this->signalFd != -1)
+        ::close(this->signalFd);
+    ::close(this->wakeUpFd);
+    ::close(this->epollFd);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+bool EpollEventDispatcher::watchSignals(const QList<int> &signalNumbers)
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    foreach (int signalNumber, signalNumbers)
+        sigaddset(&mask, signalNumber);
+
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) != 0)
+        return false;
+
+    this->signalFd = signalfd(this->signalFd, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (this->signalFd == -1) {
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+        return false;
+    }
+
+    struct epoll_event event;
+    event.events   = EPOLLIN;
+    event.data.u64 = SIGNAL_TAG;
+    epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->signalFd, &event);
+    return true;
+}
+
+bool EpollEventDispatcher::isWatchingSignals() const
+{
+    return this->signalFd != -1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool EpollEventDispatcher::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    this->interrupted.fetchAndStoreRelaxed(0);
+    emit this->awake();
+
+    QCoreApplication::sendPostedEvents();
+    bool canWait = (flags & QEventLoop::WaitForMoreEvents) && this->interrupted == 0
+            && qGlobalPostedEventsCount() == 0 && this->zeroTimers.isEmpty();
+
+    // The excluded sockets are removed from the wait set, otherwise a ready socket would wake up every epoll_wait()
+    // without being dispatched and the loop would spin
+    bool excludeSockets = flags & QEventLoop::ExcludeSocketNotifiers;
+    if (excludeSockets) {
+        foreach (int fd, this->sockets.keys())
+            epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, NULL);
+    }
+
+    if (canWait)
+        emit this->aboutToBlock();
+
+    struct epoll_event events[MAX_EVENTS];
+    int numEvents;
+    do {
+        numEvents = epoll_wait(this->epollFd, events, MAX_EVENTS, canWait ? -1 : 0);
+    } while (numEvents == -1 && errno == EINTR);
+
+    if (excludeSockets) {
+        foreach (int fd, this->sockets.keys())
+            this->updateSocket(fd);
+    }
+
+    if (numEvents > 0)
+        emit this->awake();
+
+    // Sort by priority, keeping the order of epoll for the same priority
+    QVarLengthArray<ReadyEvent, MAX_EVENTS> ready;
+    for (int n = 0; n < numEvents; n++) {
+        ReadyEvent event;
+        event.data     = events[n].data.u64;
+        event.events   = events[n].events;
+        event.priority = ((event.data & ~Q_UINT64_C(0xFFFFFFFF)) == SOCKET_TAG)
+                ? this->priorities.value((int)event.data, DEFAULT_PRIORITY)
+                : DEFAULT_PRIORITY;
+        ready.append(event);
+    }
+    qStableSort(ready.begin(), ready.end(), EpollEventDispatcher::higherPriority);
+
+    bool ret = false;
+    for (int n = 0; n < ready.size() && this->interrupted == 0; n++)
+        ret |= this->dispatch(ready[n]);
+
+    // The zero timers are sent once per iteration. A timer registered by one of them waits for the next iteration
+    QList<int> zeroTimers = this->zeroTimers;
+    for (int n = 0; n < zeroTimers.size() && this->interrupted == 0; n++) {
+        // The timer could have been unregistered by a previous event of this iteration
+        if (!this->timers.contains(zeroTimers.at(n)))
+            continue;
+
+        QTimerEvent timerEvent(zeroTimers.at(n));
+        QCoreApplication::sendEvent(this->timers.value(zeroTimers.at(n)).object, &timerEvent);
+        ret = true;
+    }
+
+    return ret;
+}
+
+bool EpollEventDispatcher::hasPendingEvents()
+{
+    return qGlobalPostedEventsCount() > 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void EpollEventDispatcher::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    int fd = notifier->socket();
+    if (!this->sockets.contains(fd)) {
+        Socket socket;
+        socket.notifiers[QSocketNotifier::Read]      = NULL;
+        socket.notifiers[QSocketNotifier::Write]     = NULL;
+        socket.notifiers[QSocketNotifier::Exception] = NULL;
+        this->sockets.insert(fd, socket);
+    }
+
+    this->sockets[fd].notifiers[notifier->type()] = notifier;
+    this->updateSocket(fd);
+}
+
+void EpollEventDispatcher::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    int fd = notifier->socket();
+    if (!this->sockets.contains(fd) || this->sockets.value(fd).notifiers[notifier->type()] != notifier)
+        return;
+
+    this->sockets[fd].notifiers[notifier->type()] = NULL;
+    this->updateSocket(fd);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void EpollEventDispatcher::registerTimer(int timerId, int interval, QObject *object)
+{
+    Timer timer;
+    timer.fd       = -1;
+    timer.interval = interval;
+    timer.object   = object;
+
+    // The zero timers don't need a timerfd, they are sent directly by processEvents()
+    if (interval == 0) {
+        this->timers.insert(timerId, timer);
+        this->zeroTimers.append(timerId);
+        return;
+    }
+
+    timer.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer.fd == -1) {
+        qWarning() << "Couldn't create a timerfd";
+        return;
+    }
+
+    EpollEventDispatcher::armTimer(timer.fd, interval);
+
+    struct epoll_event event;
+    event.events   = EPOLLIN;
+    event.data.u64 = TIMER_TAG | (quint32)timerId;
+    epoll_ctl(this->epollFd, EPOLL_CTL_ADD, timer.fd, &event);
+
+    this->timers.insert(timerId, timer);
+}
+
+bool EpollEventDispatcher::unregisterTimer(int timerId)
+{
+    if (!this->timers.contains(timerId))
+        return false;
+
+    // Closing the timerfd removes it from epoll
+    Timer timer = this->timers.take(timerId);
+    if (timer.fd != -1)
+        ::close(timer.fd);
+    else
+        this->zeroTimers.removeOne(timerId);
+    return true;
+}
+
+bool EpollEventDispatcher::unregisterTimers(QObject *object)
+{
+    bool ret = false;
+    foreach (int timerId, this->timers.keys()) {
+        if (this->timers.value(timerId).object == object)
+            ret |= this->unregisterTimer(timerId);
+    }
+    return ret;
+}
+
+QList<QAbstractEventDispatcher::TimerInfo> EpollEventDispatcher::registeredTimers(QObject *object) const
+{
+    QList<QAbstractEventDispatcher::TimerInfo> ret;
+    QHashIterator<int, Timer> it(this->timers);
+    while (it.hasNext()) {
+        it.next();
+        if (it.value().object == object)
+            ret.append(QAbstractEventDispatcher::TimerInfo(it.key(), it.value().interval));
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void EpollEventDispatcher::wakeUp()
+{
+    // A saturated eventfd (EAGAIN) already wakes up the dispatcher, so only the interrupted writes are retried
+    quint64 value = 1;
+    ssize_t ret;
+    do {
+        ret = ::write(this->wakeUpFd, &value, sizeof(value));
+    } while (ret == -1 && errno == EINTR);
+}
+
+void EpollEventDispatcher::interrupt()
+{
+    this->interrupted.fetchAndStoreRelaxed(1);
+    this->wakeUp();
+}
+
+void EpollEventDispatcher::flush() {}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void EpollEventDispatcher::updateSocket(int fd)
+{
+    const Socket &socket = this->sockets[fd];
+
+    struct epoll_event event;
+    event.events   = 0;
+    event.data.u64 = SOCKET_TAG | (quint32)fd;
+    if (socket.notifiers[QSocketNotifier::Read] != NULL)
+        event.events |= EPOLLIN;
+    if (socket.notifiers[QSocketNotifier::Write] != NULL)
+        event.events |= EPOLLOUT;
+    if (socket.notifiers[QSocketNotifier::Exception] != NULL)
+        event.events |= EPOLLPRI;
+
+    if (event.events == 0) {
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, &event);
+        this->sockets.remove(fd);
+    } else if (epoll_ctl(this->epollFd, EPOLL_CTL_MOD, fd, &event) == -1 && errno == ENOENT) {
+        epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+bool EpollEventDispatcher::dispatch(const ReadyEvent &event)
+{
+    quint64 tag = event.data & ~Q_UINT64_C(0xFFFFFFFF);
+    int id = (int)(event.data & Q_UINT64_C(0xFFFFFFFF));
+
+    if (tag == WAKEUP_TAG) {
+        // EAGAIN means that the eventfd has already been reset
+        quint64 value;
+        ssize_t ret;
+        do {
+            ret = ::read(this->wakeUpFd, &value, sizeof(value));
+        } while (ret == -1 && errno == EINTR);
+
+        QCoreApplication::sendPostedEvents();
+        return true;
+
+    } else if (tag == SIGNAL_TAG) {
+        struct signalfd_siginfo info;
+        while (::read(this->signalFd, &info, sizeof(info)) == sizeof(info))
+            emit this->unixSignal(info.ssi_signo);
+        return true;
+
+    } else if (tag == TIMER_TAG) {
+        // The timer could have been unregistered by a previous event of this iteration
+        if (!this->timers.contains(id))
+            return false;
+
+        quint64 expirations;
+        if (::read(this->timers.value(id).fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+            return false;
+
+        QTimerEvent timerEvent(id);
+        QCoreApplication::sendEvent(this->timers.value(id).object, &timerEvent);
+        return true;
+
+    } else {
+        // A notifier could have been unregistered by a previous event of this iteration, so look for them every time
+        bool ret = false;
+        const QSocketNotifier::Type types[] = { QSocketNotifier::Read, QSocketNotifier::Write,
+                QSocketNotifier::Exception };
+        const quint32 masks[] = { EPOLLIN | EPOLLHUP | EPOLLERR, EPOLLOUT | EPOLLHUP | EPOLLERR, EPOLLPRI };
+
+        for (int n = 0; n < 3; n++) {
+            if (!(event.events & masks[n]) || !this->sockets.contains(id))
+                continue;
+
+            QSocketNotifier *notifier = this->sockets.value(id).notifiers[types[n]];
+            if (notifier != NULL && notifier->isEnabled()) {
+                QEvent socketEvent(QEvent::SockAct);
+                QCoreApplication::sendEvent(notifier, &socketEvent);
+                ret = true;
+            }
+        }
+        return ret;
+    }
+}
+
+bool EpollEventDispatcher::higherPriority(const ReadyEvent &a, const ReadyEvent &b)
+{
+    return a.priority > b.priority;
+}
+
+void EpollEventDispatcher::armTimer(int fd, int interval)
+{
+    struct itimerspec spec;
+    spec.it_interval.tv_sec  = interval / 1000;
+    spec.it_interval.tv_nsec = (interval % 1000) * 1000000;
+    spec.it_value = spec.it_interval;
+
+    timerfd_settime(fd, 0, &spec, NULL);
+}
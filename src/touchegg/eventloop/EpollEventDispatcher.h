@@ -0,0 +1,207 @@
+/**
+ * @file /src/touchegg/eventloop/EpollEventDispatcher.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  EpollEventDispatcher
+ */
+#ifndef EPOLLEVENTDISPATCHER_H
+#define EPOLLEVENTDISPATCHER_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Lightweight event dispatcher for the main thread, built directly on epoll:
+ * - Each socket notifier is an epoll registration of its file descriptor.
+ * - Each timer is a timerfd, except the zero timers that are sent in every iteration.
+ * - The Unix signals can be received through a signalfd, see watchSignals().
+ * - Posted events and wakeUp() are signaled with an eventfd.
+ *
+ * When several file descriptors are ready in the same iteration the socket notifiers are dispatched in priority order,
+ * see setSocketPriority(), so the GEIS events are always drained before the X events and the timers.
+ *
+ * To be used it must be constructed before the application, see Main.cpp.
+ */
+class EpollEventDispatcher : public QAbstractEventDispatcher
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Priorities of the sockets used by Touchégg. Higher priorities are dispatched first.
+     */
+    enum SocketPriority {
+        DEFAULT_PRIORITY = 0,
+        X_PRIORITY       = 1,
+        GEIS_PRIORITY    = 2
+    };
+
+    /**
+     * Default constructor.
+     * @param parent The parent of the class.
+     */
+    EpollEventDispatcher(QObject *parent = 0);
+
+    /**
+     * Destructor.
+     */
+    virtual ~EpollEventDispatcher();
+
+    /**
+     * Sets the priority of a file descriptor, if the dispatcher of the main thread is an EpollEventDispatcher.
+     * Otherwise does nothing.
+     * @param fd       The file descriptor.
+     * @param priority The priority.
+     */
+    static void setSocketPriority(int fd, SocketPriority priority);
+
+    /**
+     * Blocks the indicated Unix signals and receives them through a signalfd, emitting unixSignal(). Must be called
+     * before creating any thread, so all the threads inherit the signal mask.
+     * @param  signalNumbers The signals.
+     * @return If the signalfd could be created.
+     */
+    bool watchSignals(const QList<int> &signalNumbers);
+
+    /**
+     * Returns if watchSignals() has been called successfully.
+     * @return true if the signals are received through the signalfd.
+     */
+    bool isWatchingSignals() const;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    bool processEvents(QEventLoop::ProcessEventsFlags flags);
+    bool hasPendingEvents();
+
+    void registerSocketNotifier(QSocketNotifier *notifier);
+    void unregisterSocketNotifier(QSocketNotifier *notifier);
+
+    void registerTimer(int timerId, int interval, QObject *object);
+    bool unregisterTimer(int timerId);
+    bool unregisterTimers(QObject *object);
+    QList<TimerInfo> registeredTimers(QObject *object) const;
+
+    void wakeUp();
+    void interrupt();
+    void flush();
+
+signals:
+
+    /**
+     * Emitted when a signal watched with watchSignals() is received.
+     * @param signalNumber The signal number.
+     */
+    void unixSignal(int signalNumber);
+
+private:
+
+    /**
+     * Socket notifiers of a file descriptor.
+     */
+    struct Socket {
+        QSocketNotifier *notifiers[3]; ///< Indexed by QSocketNotifier::Type.
+    };
+
+    /**
+     * A timer and its timerfd, -1 for the zero timers.
+     */
+    struct Timer {
+        int fd;
+        int interval;
+        QObject *object;
+    };
+
+    /**
+     * A ready file descriptor to dispatch.
+     */
+    struct ReadyEvent {
+        quint64 data;
+        quint32 events;
+        int priority;
+    };
+
+    /**
+     * Tags of the epoll data, the low 32 bits are the file descriptor or the timer ID.
+     */
+    static const quint64 SOCKET_TAG = Q_UINT64_C(0) << 32;
+    static const quint64 TIMER_TAG  = Q_UINT64_C(1) << 32;
+    static const quint64 WAKEUP_TAG = Q_UINT64_C(2) << 32;
+    static const quint64 SIGNAL_TAG = Q_UINT64_C(3) << 32;
+
+    /**
+     * Updates the epoll registration of a file descriptor after its notifiers have changed.
+     * @param fd The file descriptor.
+     */
+    void updateSocket(int fd);
+
+    /**
+     * Dispatches a ready file descriptor.
+     * @param  event The event.
+     * @return If an event was delivered.
+     */
+    bool dispatch(const ReadyEvent &event);
+
+    /**
+     * Comparator to sort the ready file descriptors by priority.
+     */
+    static bool higherPriority(const ReadyEvent &a, const ReadyEvent &b);
+
+    /**
+     * Arms the timerfd of a timer.
+     * @param fd       The timerfd.
+     * @param interval Interval in milliseconds, greater than 0.
+     */
+    static void armTimer(int fd, int interval);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * File descriptors of epoll, the wake up eventfd and the signalfd (-1 if not used).
+     */
+    int epollFd;
+    int wakeUpFd;
+    int signalFd;
+
+    /**
+     * Socket notifiers by file descriptor.
+     */
+    QHash<int, Socket> sockets;
+
+    /**
+     * Priorities by file descriptor. The file descriptors not included have DEFAULT_PRIORITY.
+     */
+    QHash<int, int> priorities;
+
+    /**
+     * Timers by ID.
+     */
+    QHash<int, Timer> timers;
+
+    /**
+     * IDs of the timers with interval 0, in registration order.
+     */
+    QList<int> zeroTimers;
+
+    /**
+     * Set by interrupt(), makes processEvents() return as soon as possible.
+     */
+    QAtomicInt interrupted;
+
+};
+
+#endif // EPOLLEVENTDISPATCHER_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/eventloop/EpollEventDispatcher.h
+
+SOURCES += \
+    src/touchegg/eventloop/EpollEventDispatcher.cpp
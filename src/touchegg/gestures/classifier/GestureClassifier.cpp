@@ -0,0 +1,180 @@
+/**
+ * @file /src/touchegg/gestures/classifier/GestureClassifier.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  GestureClassifier
+ */
+#include "GestureClassifier.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+GestureClassifier::GestureClassifier()
+    : first(0),
+      numFrames(0),
+      id(-1),
+      composed(false),
+      displacementX(0),
+      displacementY(0),
+      firstTimestamp(0),
+      lastTimestamp(0),
+      threshold(0),
+      time(0)
+{
+    this->clock.start();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void GestureClassifier::begin(const QString &type, int id, bool isComposed)
+{
+    this->clear();
+    this->type     = type;
+    this->id       = id;
+    this->composed = isComposed;
+}
+
+void GestureClassifier::addFrame(const QHash<QString, QVariant>& attrs, bool isUpdate)
+{
+    qint64 timestamp = this->getTimestamp(attrs);
+    if (this->numFrames == 0)
+        this->firstTimestamp = timestamp;
+    this->lastTimestamp = timestamp;
+
+    this->displacementX += attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat();
+    this->displacementY += attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat();
+
+    // If the buffer is full overwrite the oldest frame
+    int index = (this->first + this->numFrames) % CAPACITY;
+    if (this->numFrames == CAPACITY)
+        this->first = (this->first + 1) % CAPACITY;
+    else
+        this->numFrames++;
+
+    this->frames[index].attrs    = attrs;
+    this->frames[index].isUpdate = isUpdate;
+}
+
+bool GestureClassifier::isReady() const
+{
+    if (this->displacementX == 0 && this->displacementY == 0)
+        return false;
+
+    float displacement = std::sqrt(this->displacementX * this->displacementX
+            + this->displacementY * this->displacementY);
+
+    return displacement >= this->threshold
+            || this->numFrames == CAPACITY
+            || this->lastTimestamp - this->firstTimestamp >= this->time;
+}
+
+void GestureClassifier::clear()
+{
+    for (int n = 0; n < this->numFrames; n++)
+        this->frames[(this->first + n) % CAPACITY].attrs.clear();
+
+    this->first          = 0;
+    this->numFrames      = 0;
+    this->id             = -1;
+    this->composed       = false;
+    this->displacementX  = 0;
+    this->displacementY  = 0;
+    this->firstTimestamp = 0;
+    this->lastTimestamp  = 0;
+}
+
+qint64 GestureClassifier::getTimestamp(const QHash<QString, QVariant>& attrs) const
+{
+    QHash<QString, QVariant>::const_iterator it = attrs.constFind(GEIS_GESTURE_ATTRIBUTE_TIMESTAMP);
+    if (it != attrs.constEnd())
+        return it.value().toLongLong();
+
+    return this->clock.elapsed();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                          GET/SET/IS                                          ********** //
+// ****************************************************************************************************************** //
+
+bool GestureClassifier::isActive() const
+{
+    return this->id != -1;
+}
+
+const QString &GestureClassifier::getType() const
+{
+    return this->type;
+}
+
+int GestureClassifier::getId() const
+{
+    return this->id;
+}
+
+bool GestureClassifier::isComposed() const
+{
+    return this->composed;
+}
+
+QHash<QString, QVariant> GestureClassifier::getClassificationAttrs() const
+{
+    QHash<QString, QVariant> ret;
+    if (this->numFrames > 0)
+        ret = this->frames[(this->first + this->numFrames - 1) % CAPACITY].attrs;
+
+    ret.insert(GEIS_GESTURE_ATTRIBUTE_DELTA_X, this->displacementX);
+    ret.insert(GEIS_GESTURE_ATTRIBUTE_DELTA_Y, this->displacementY);
+    return ret;
+}
+
+int GestureClassifier::getNumFrames() const
+{
+    return this->numFrames;
+}
+
+const QHash<QString, QVariant>& GestureClassifier::getFrame(int n, bool *isUpdate) const
+{
+    const Frame &frame = this->frames[(this->first + n) % CAPACITY];
+    *isUpdate = frame.isUpdate;
+    return frame.attrs;
+}
+
+float GestureClassifier::getVelocity() const
+{
+    qint64 elapsed = this->lastTimestamp - this->firstTimestamp;
+    if (elapsed <= 0)
+        return 0;
+
+    return std::sqrt(this->displacementX * this->displacementX + this->displacementY * this->displacementY) / elapsed;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void GestureClassifier::setThreshold(float threshold)
+{
+    this->threshold = threshold;
+}
+
+void GestureClassifier::setTime(int time)
+{
+    this->time = time;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file /src/touchegg/gestures/classifier/GestureClassifier.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  GestureClassifier
+ */
+#ifndef GESTURECLASSIFIER_H
+#define GESTURECLASSIFIER_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Classification window of the gestures whose direction depends on their movement (drag and tap & hold). Instead of
+ * using the delta of the first frame, that is usually noisy, the frames are buffered until the accumulated displacement
+ * reaches a threshold, or until the window is full (CAPACITY frames or the configured time, measured with the GEIS
+ * timestamps). Then the gesture is classified with the accumulated displacement and the buffered frames are replayed.
+ *
+ * Fast gestures reach the threshold in one or two frames, so no fixed latency is added, and slow gestures are
+ * classified when the time expires.
+ */
+class GestureClassifier
+{
+
+public:
+
+    /**
+     * Maximum number of frames buffered (K). If more frames arrive before the gesture is classified, what only happens
+     * when their displacement cancel out, the oldest ones are overwritten.
+     */
+    static const int CAPACITY = 8;
+
+    /**
+     * Creates an inactive classifier.
+     */
+    GestureClassifier();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Starts the classification of a gesture, discarding the previous one.
+     * @param type       Gesture type, in GEIS format.
+     * @param id         Gesture ID.
+     * @param isComposed If the gesture is the second part of a composed gesture (tap & hold).
+     */
+    void begin(const QString &type, int id, bool isComposed);
+
+    /**
+     * Adds a frame of the gesture.
+     * @param attrs    Gesture attributes.
+     * @param isUpdate If the frame is an update, false for the start frame.
+     */
+    void addFrame(const QHash<QString, QVariant>& attrs, bool isUpdate);
+
+    /**
+     * Returns if the gesture can be classified: the displacement has reached the threshold or the window is full and
+     * the displacement is not 0.
+     * @return If it is ready.
+     */
+    bool isReady() const;
+
+    /**
+     * Ends the classification.
+     */
+    void clear();
+
+    /**
+     * Returns the timestamp of a frame: the GEIS timestamp or, if the frame doesn't have one, a monotonic clock.
+     * @param  attrs Gesture attributes.
+     * @return The timestamp in milliseconds.
+     */
+    qint64 getTimestamp(const QHash<QString, QVariant>& attrs) const;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Returns if a gesture is being classified.
+     * @return If it is active.
+     */
+    bool isActive() const;
+
+    /**
+     * Returns the type, the ID and if it is a composed gesture.
+     * @see begin()
+     */
+    const QString &getType() const;
+    int getId() const;
+    bool isComposed() const;
+
+    /**
+     * Returns the attributes to classify the gesture: the attributes of the last frame with the accumulated
+     * displacement as delta.
+     * @return The attributes.
+     */
+    QHash<QString, QVariant> getClassificationAttrs() const;
+
+    /**
+     * Returns the number of buffered frames.
+     * @return The number of frames.
+     */
+    int getNumFrames() const;
+
+    /**
+     * Returns a buffered frame, being 0 the oldest.
+     * @param  n        Index of the frame.
+     * @param  isUpdate Returns if the frame is an update.
+     * @return The attributes of the frame.
+     */
+    const QHash<QString, QVariant>& getFrame(int n, bool *isUpdate) const;
+
+    /**
+     * Returns the speed of the gesture in the window, in millimetres per millisecond.
+     * @return The speed, 0 if the frames have the same timestamp.
+     */
+    float getVelocity() const;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Sets the displacement, in millimetres, needed to classify the gesture. 0 classifies it with the first frame that
+     * moves.
+     * @param threshold The threshold.
+     */
+    void setThreshold(float threshold);
+
+    /**
+     * Sets the maximum duration of the window (T).
+     * @param time The time in milliseconds.
+     */
+    void setTime(int time);
+
+private:
+
+    /**
+     * Buffered frame.
+     */
+    struct Frame {
+        QHash<QString, QVariant> attrs;
+        bool isUpdate;
+    };
+
+    /**
+     * Ring buffer with the frames. The oldest one is frames[first].
+     */
+    Frame frames[CAPACITY];
+    int first;
+    int numFrames;
+
+    /**
+     * Gesture being classified, id is -1 if the classifier is inactive.
+     */
+    QString type;
+    int id;
+    bool composed;
+
+    /**
+     * Accumulated displacement of all the frames, including the overwritten ones.
+     */
+    float displacementX;
+    float displacementY;
+
+    /**
+     * Timestamps of the first and last frames.
+     */
+    qint64 firstTimestamp;
+    qint64 lastTimestamp;
+
+    /**
+     * Settings.
+     */
+    float threshold;
+    int time;
+
+    /**
+     * Clock used when the frames don't have timestamp.
+     */
+    QElapsedTimer clock;
+
+};
+
+#endif // GESTURECLASSIFIER_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/gestures/classifier/GestureClassifier.h
+
+SOURCES += \
+    src/touchegg/gestures/classifier/GestureClassifier.cpp
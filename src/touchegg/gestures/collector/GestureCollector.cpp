@@ -32,6 +32,8 @@ void GestureCollector::gestureStart(GestureCollector *gc, GeisEvent event)
     QHash<QString, QVariant> attrs = getGestureAttrs(event);
     QString type = attrs.value(GEIS_GESTURE_ATTRIBUTE_GESTURE_NAME).toString();
     int id = attrs.value("geis gesture class id").toInt();
+    if (gc->recorder != NULL)
+        gc->recorder->record(TraceRecorder::GESTURE_START, type, id, attrs);
     emit gc->executeGestureStart(type, id, attrs);
 }
 
@@ -40,6 +42,8 @@ void GestureCollector::gestureUpdate(GestureCollector *gc, GeisEvent event)
     QHash<QString, QVariant> attrs = getGestureAttrs(event);
     QString type = attrs.value(GEIS_GESTURE_ATTRIBUTE_GESTURE_NAME).toString();
     int id = attrs.value("geis gesture class id").toInt();
+    if (gc->recorder != NULL)
+        gc->recorder->record(TraceRecorder::GESTURE_UPDATE, type, id, attrs);
     emit gc->executeGestureUpdate(type, id, attrs);
 }
 
@@ -48,6 +52,8 @@ void GestureCollector::gestureFinish(GestureCollector *gc, GeisEvent event)
     QHash<QString, QVariant> attrs = getGestureAttrs(event);
     QString type = attrs.value(GEIS_GESTURE_ATTRIBUTE_GESTURE_NAME).toString();
     int id = attrs.value("geis gesture class id").toInt();
+    if (gc->recorder != NULL)
+        gc->recorder->record(TraceRecorder::GESTURE_FINISH, type, id, attrs);
     emit gc->executeGestureFinish(type, id, attrs);
 }
 
@@ -57,7 +63,8 @@ void GestureCollector::gestureFinish(GestureCollector *gc, GeisEvent event)
 // ****************************************************************************************************************** //
 
 GestureCollector::GestureCollector(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      recorder(NULL)
 {
     this->geis = geis_new(GEIS_INIT_TRACK_DEVICES, NULL);
 
@@ -68,15 +75,28 @@ GestureCollector::GestureCollector(QObject *parent)
     int fd;
     geis_get_configuration(this->geis, GEIS_CONFIGURATION_FD, &fd);
     this->socketNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    EpollEventDispatcher::setSocketPriority(fd, EpollEventDispatcher::GEIS_PRIORITY);
     connect(this->socketNotifier, SIGNAL(activated(int)), SLOT(geisEvent()));
 }
 
 GestureCollector::~GestureCollector()
 {
+    delete this->recorder;
     geis_delete(this->geis);
 }
 
 
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void GestureCollector::startRecording(const QString &fileName)
+{
+    delete this->recorder;
+    this->recorder = new TraceRecorder(fileName);
+}
+
+
 // ****************************************************************************************************************** //
 // **********                                         PUBLIC SLOTS                                         ********** //
 // ****************************************************************************************************************** //
@@ -87,7 +107,7 @@ void GestureCollector::addWindow(Window w)
     Config *cfg = Config::getInstance();
 
     QList< QPair<QStringList, int> > subscribeList;
-    if (w == QX11Info::appRootWindow())
+    if (w == XConnection::rootWindow())
         subscribeList = cfg->getUsedGestures("All");
     else
         subscribeList = cfg->getUsedGestures(this->getWindowClass(w));
@@ -170,6 +190,7 @@ void GestureCollector::geisEvent()
 {
     GeisStatus status;
 
+    LatencyStats::eventsReady();
     status = geis_dispatch_events(this->geis);
     if (status != GEIS_STATUS_SUCCESS) {
         qWarning("Failed to dispatch geis events");
@@ -197,12 +218,22 @@ void GestureCollector::geisEvent()
             setupGestureEvent(event);
             break;
 
+        case GEIS_EVENT_DEVICE_AVAILABLE:
+            GestureCollector::deviceAvailable(event);
+            break;
+        case GEIS_EVENT_DEVICE_UNAVAILABLE:
+            GestureCollector::deviceUnavailable(event);
+            break;
+
         default:
             break;
         }
 
         geis_event_delete(event);
+        LatencyStats::eventProcessed();
     }
+
+    LatencyStats::eventsDone();
 }
 
 
@@ -276,24 +307,47 @@ QHash<QString, QVariant> GestureCollector::getGestureAttrs(GeisEvent event)
             int rootX,rootY, winX, winY;
             Window child, root;
             unsigned int mask;
-            XQueryPointer(QX11Info::display(), QX11Info::appRootWindow(),
+            XCalls::queryPointer(XConnection::display(), XConnection::rootWindow(),
                     &root, &child, &rootX, &rootY, &winX, &winY, &mask);
             ret.insert(GEIS_GESTURE_ATTRIBUTE_CHILD_WINDOW_ID,
                     (qulonglong)child);
+
+            // The touches of the frame, to tell apart the gestures made at the same time with different fingers
+            quint64 touchMask = 0;
+            for (GeisSize t = 0; t < geis_frame_touchid_count(frame); ++t)
+                touchMask |= Q_UINT64_C(1) << (geis_frame_touchid(frame, t) % 64);
+            ret.insert(TOUCHEGG_GESTURE_ATTRIBUTE_TOUCH_MASK, (qulonglong)touchMask);
         }
     }
 
+    // The deltas in millimetres
+    DeviceTable::getInstance()->normalizeDeltas(ret);
+
+    LatencyStats::mark(LatencyStats::FRAME_DECODED);
     return ret;
 }
 
 QString GestureCollector::getWindowClass(Window window) const
 {
-    XClassHint *classHint = XAllocClassHint();
-    XGetClassHint(QX11Info::display(), window, classHint);
-    QString ret = classHint->res_class;
-    XFree(classHint->res_class);
-    XFree(classHint->res_name);
-    return ret;
+    return XcbCalls::getWindowClass(XConnection::display(), window);
+}
+
+QVariant GestureCollector::getDeviceAttr(GeisDevice device, const char *name)
+{
+    GeisAttr attr = geis_device_attr_by_name(device, name);
+    if (attr == NULL)
+        return QVariant();
+
+    switch (geis_attr_type(attr)) {
+    case GEIS_ATTR_TYPE_BOOLEAN:
+        return (bool)geis_attr_value_to_boolean(attr);
+    case GEIS_ATTR_TYPE_FLOAT:
+        return geis_attr_value_to_float(attr);
+    case GEIS_ATTR_TYPE_INTEGER:
+        return geis_attr_value_to_integer(attr);
+    default:
+        return QVariant();
+    }
 }
 
 void GestureCollector::setupGestureEvent(GeisEvent event)
@@ -309,3 +363,32 @@ void GestureCollector::setupGestureEvent(GeisEvent event)
 
     GestureCollector::gestures.append(gesture_class);
 }
+
+void GestureCollector::deviceAvailable(GeisEvent event)
+{
+    GeisAttr attr = geis_event_attr_by_name(event, GEIS_EVENT_ATTRIBUTE_DEVICE);
+    GeisDevice device = (GeisDevice)geis_attr_value_to_pointer(attr);
+
+    DeviceInfo info;
+    info.id          = geis_device_id(device);
+    info.name        = geis_device_name(device);
+    info.touches     = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_TOUCHES).toInt();
+    info.direct      = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_DIRECT_TOUCH).toBool();
+    info.minX        = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_MIN_X).toFloat();
+    info.maxX        = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_MAX_X).toFloat();
+    info.minY        = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_MIN_Y).toFloat();
+    info.maxY        = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_MAX_Y).toFloat();
+    info.resolutionX = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_RES_X).toFloat();
+    info.resolutionY = getDeviceAttr(device, GEIS_DEVICE_ATTRIBUTE_RES_Y).toFloat();
+
+    DeviceTable::getInstance()->addDevice(info);
+}
+
+void GestureCollector::deviceUnavailable(GeisEvent event)
+{
+    GeisAttr attr = geis_event_attr_by_name(event, GEIS_EVENT_ATTRIBUTE_DEVICE);
+    GeisDevice device = (GeisDevice)geis_attr_value_to_pointer(attr);
+
+    qDebug() << "[+] Removed device:" << geis_device_name(device);
+    DeviceTable::getInstance()->removeDevice(geis_device_id(device));
+}
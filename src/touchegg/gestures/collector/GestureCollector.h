@@ -23,6 +23,18 @@
 
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/config/Config.h"
+#include "src/touchegg/eventloop/EpollEventDispatcher.h"
+#include "src/touchegg/stats/LatencyStats.h"
+#include "src/touchegg/x11/XCalls.h"
+#include "src/touchegg/x11/XcbCalls.h"
+#include "src/touchegg/gestures/trace/TraceRecorder.h"
+#include "src/touchegg/devices/DeviceTable.h"
+
+/**
+ * Attribute added to the gestures with their touches: a qulonglong with the bit "touch ID % 64" set for each touch of
+ * the frame.
+ */
+#define TOUCHEGG_GESTURE_ATTRIBUTE_TOUCH_MASK "touchegg touch mask"
 
 /**
  * Collect all the gestures using utouch-geis and emits signals to report it.
@@ -66,6 +78,27 @@ public:
      */
     static void setupGestureEvent(GeisEvent event);
 
+    /**
+     * Adds the device of the event to the DeviceTable.
+     * @param event Event with the available device.
+     */
+    static void deviceAvailable(GeisEvent event);
+
+    /**
+     * Removes the device of the event from the DeviceTable.
+     * @param event Event with the unavailable device.
+     */
+    static void deviceUnavailable(GeisEvent event);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Records all the gestures collected from now on in the specified trace file.
+     * @param fileName The file.
+     * @see TraceRecorder
+     */
+    void startRecording(const QString &fileName);
+
 public slots:
 
     /**
@@ -127,6 +160,14 @@ private:
      */
     QString getWindowClass(Window window) const;
 
+    /**
+     * Returns the value of an attribute of a device.
+     * @param  device The device.
+     * @param  name   Name of the attribute.
+     * @return The value, or a null QVariant if the device doesn't have it.
+     */
+    static QVariant getDeviceAttr(GeisDevice device, const char *name);
+
     //------------------------------------------------------------------------------------------------------------------
 
     /**
@@ -149,6 +190,11 @@ private:
      */
     QHash <Window, QList<GeisSubscription> > subscriptions;
 
+    /**
+     * Records the gestures in a trace file, NULL if not recording.
+     */
+    TraceRecorder *recorder;
+
     /**
      * Saves a list of the avalilable gesture classes.
      */
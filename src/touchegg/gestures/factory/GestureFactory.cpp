@@ -52,24 +52,9 @@ Gesture *GestureFactory::createSimpleGesture(const QString &type, int id, QHash<
 
     // DRAG
     } else if (type == GEIS_GESTURE_DRAG) {
-        float deltaX = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat();
-        float deltaY = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat();
-
-        // UP
-        if (deltaY < 0 && abs(deltaY) > abs(deltaX))
-            return new Gesture(GestureTypeEnum::DRAG, numFingers, GestureDirectionEnum::UP, id, attrs);
-
-        // DOWN
-        else if (deltaY > 0 && abs(deltaY) > abs(deltaX))
-            return new Gesture(GestureTypeEnum::DRAG, numFingers, GestureDirectionEnum::DOWN, id, attrs);
-
-        // LEFT
-        else if (deltaX < 0 && abs(deltaX) > abs(deltaY))
-            return new Gesture(GestureTypeEnum::DRAG, numFingers, GestureDirectionEnum::LEFT, id, attrs);
-
-        // RIGHT
-        else if (deltaX > 0 && abs(deltaX) > abs(deltaY))
-            return new Gesture(GestureTypeEnum::DRAG, numFingers, GestureDirectionEnum::RIGHT, id, attrs);
+        GestureDirectionEnum::GestureDirection dir = GestureFactory::getDirection(attrs);
+        if (dir != GestureDirectionEnum::NO_DIRECTION)
+            return new Gesture(GestureTypeEnum::DRAG, numFingers, dir, id, attrs);
 
     // PINCH
     } else if (type == GEIS_GESTURE_PINCH) {
@@ -108,28 +93,9 @@ Gesture *GestureFactory::createComposedGesture(const QString &type, int id,
 
     // TAP & HOLD
     if (type == GEIS_GESTURE_DRAG) {
-        float deltaX = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat();
-        float deltaY = attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat();
-
-        // UP
-        if (deltaY < 0 && abs(deltaY) > abs(deltaX))
-            return new Gesture(GestureTypeEnum::TAP_AND_HOLD, numFingers, GestureDirectionEnum::UP, id, attrs);
-
-        // DOWN
-        else if (deltaY > 0 && abs(deltaY) > abs(deltaX))
-            return new Gesture(GestureTypeEnum::TAP_AND_HOLD, numFingers, GestureDirectionEnum::DOWN, id, attrs);
-
-        // LEFT
-        else if (deltaX < 0 && abs(deltaX) > abs(deltaY))
-            return new Gesture(GestureTypeEnum::TAP_AND_HOLD, numFingers, GestureDirectionEnum::LEFT, id, attrs);
-
-        // RIGHT
-        else if (deltaX > 0 && abs(deltaX) > abs(deltaY))
-            return new Gesture(GestureTypeEnum::TAP_AND_HOLD, numFingers, GestureDirectionEnum::RIGHT, id, attrs);
-
-    // DOUBLE TAP
-    } else if (type == GEIS_GESTURE_TAP) {
-        return new Gesture(GestureTypeEnum::DOUBLE_TAP, numFingers, GestureDirectionEnum::NO_DIRECTION, id, attrs);
+        GestureDirectionEnum::GestureDirection dir = GestureFactory::getDirection(attrs);
+        if (dir != GestureDirectionEnum::NO_DIRECTION)
+            return new Gesture(GestureTypeEnum::TAP_AND_HOLD, numFingers, dir, id, attrs);
 
     // UNKNOWN GESTURE
     } else {
@@ -140,3 +106,30 @@ Gesture *GestureFactory::createComposedGesture(const QString &type, int id,
 
     return NULL;
 }
+
+Gesture *GestureFactory::createTapGesture(int numTaps, int id, QHash<QString, QVariant> attrs)
+{
+    int numFingers = attrs.value(GEIS_GESTURE_ATTRIBUTE_TOUCHES).toInt();
+
+    switch (numTaps) {
+    case 1:
+        return new Gesture(GestureTypeEnum::TAP, numFingers, GestureDirectionEnum::NO_DIRECTION, id, attrs);
+    case 2:
+        return new Gesture(GestureTypeEnum::DOUBLE_TAP, numFingers, GestureDirectionEnum::NO_DIRECTION, id, attrs);
+    case 3:
+        return new Gesture(GestureTypeEnum::TRIPLE_TAP, numFingers, GestureDirectionEnum::NO_DIRECTION, id, attrs);
+    default:
+        return NULL;
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+GestureDirectionEnum::GestureDirection GestureFactory::getDirection(const QHash<QString, QVariant>& attrs)
+{
+    return GestureDirectionEnum::getDirection(attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat(),
+            attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat(), Config::getInstance()->getNumDirections());
+}
@@ -24,6 +24,7 @@
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/gestures/types/GestureTypeEnum.h"
 #include "src/touchegg/gestures/implementation/Gesture.h"
+#include "src/touchegg/config/Config.h"
 
 /**
  * Factory to create the different gestures.
@@ -54,7 +55,7 @@ public:
     Gesture *createSimpleGesture(const QString &type, int id, QHash<QString, QVariant> attrs);
 
     /**
-     * Creates a composed gesture (tap&hold, double tap...) with the specified properties.
+     * Creates a composed gesture (tap&hold) with the specified properties.
      * IMPORTANT: Don't forget to free memory.
      * @param type  Gesture type.
      * @param id    Gesture ID.
@@ -64,8 +65,27 @@ public:
      */
     Gesture *createComposedGesture(const QString &type, int id, QHash<QString, QVariant> attrs);
 
+    /**
+     * Creates the gesture of a sequence of taps: a TAP, a DOUBLE_TAP or a TRIPLE_TAP.
+     * IMPORTANT: Don't forget to free memory.
+     * @param numTaps Number of taps of the sequence, from 1 to 3.
+     * @param id      Gesture ID.
+     * @param attrs   Gesture attributes of the first tap.
+     * @return The gesture.
+     */
+    Gesture *createTapGesture(int numTaps, int id, QHash<QString, QVariant> attrs);
+
 private:
 
+    /**
+     * Returns the direction of a drag with the number of directions set in the configuration.
+     * @param  attrs Gesture attributes.
+     * @return The direction, NO_DIRECTION if the drag doesn't move.
+     */
+    static GestureDirectionEnum::GestureDirection getDirection(const QHash<QString, QVariant>& attrs);
+
+    //------------------------------------------------------------------------------------------------------------------
+
     /**
      * Single instance of the class.
      */
@@ -26,19 +26,49 @@
 
 GestureHandler::GestureHandler(QObject *parent)
     : QObject(parent),
-      currentGesture(NULL),
-      timerTap(new QTimer(this)),
+      tapMapper(new QSignalMapper(this)),
+      watchdogMapper(new QSignalMapper(this)),
       gestureFact(GestureFactory::getInstance()),
       actionFact(ActionFactory::getInstance()),
       config(Config::getInstance())
 {
-    this->timerTap->setInterval(this->config->getComposedGesturesTime());
-    connect(this->timerTap, SIGNAL(timeout()), this, SLOT(executeTap()));
+    for (int n = 0; n < MAX_DEVICES; n++) {
+        DeviceState *device = &this->devices[n];
+        device->deviceId        = -1;
+        device->touchMask       = 0;
+        device->gain            = 1;
+        device->direct          = false;
+        device->currentGesture  = NULL;
+        device->tapId           = -1;
+        device->tapWindow       = None;
+        device->speculativeTaps = 0;
+        device->timerTap        = new QTimer(this);
+        device->timerWatchdog   = new QTimer(this);
+
+        device->taps.setTime(this->config->getComposedGesturesTime());
+        device->timerTap->setSingleShot(true);
+        device->timerTap->setInterval(this->config->getComposedGesturesTime());
+        this->tapMapper->setMapping(device->timerTap, n);
+        connect(device->timerTap, SIGNAL(timeout()), this->tapMapper, SLOT(map()));
+
+        device->timerWatchdog->setSingleShot(true);
+        device->timerWatchdog->setInterval(this->config->getGestureTimeout());
+        this->watchdogMapper->setMapping(device->timerWatchdog, n);
+        connect(device->timerWatchdog, SIGNAL(timeout()), this->watchdogMapper, SLOT(map()));
+
+        device->classifier.setThreshold(this->config->getClassificationThreshold());
+        device->classifier.setTime(this->config->getClassificationTime());
+    }
+
+    connect(this->tapMapper, SIGNAL(mapped(int)), this, SLOT(executeTap(int)));
+    connect(this->watchdogMapper, SIGNAL(mapped(int)), this, SLOT(cancelGesture(int)));
 }
 
 GestureHandler::~GestureHandler()
 {
-    delete this->currentGesture;
+    // Release the keys and buttons pressed by the running gestures
+    for (int n = 0; n < MAX_DEVICES; n++)
+        this->cancelGesture(n);
 }
 
 
@@ -48,127 +78,224 @@ GestureHandler::~GestureHandler()
 
 void GestureHandler::executeGestureStart(const QString &type, int id, const QHash<QString, QVariant>& attrs)
 {
+    LatencyStats::mark(LatencyStats::HANDLER_DISPATCH);
+
+    DeviceState *device = this->getDevice(id, attrs);
+    if (device == NULL)
+        return;
+
     // If not gesture is running create one
-    if (this->currentGesture == NULL) {
-        this->currentGesture = this->createGesture(type, id, attrs, false);
-        if (this->currentGesture != NULL) {
-            qDebug() << "\tGesture Start" << id << type;
-            this->currentGesture->start();
-        }
-    }
+    if (device->currentGesture == NULL && !device->classifier.isActive())
+        this->beginGesture(device, type, id, attrs, false);
+
+    this->watchGesture(device, id, attrs);
 }
 
 void GestureHandler::executeGestureUpdate(const QString &type, int id, const QHash<QString, QVariant>& attrs)
 {
+    LatencyStats::mark(LatencyStats::HANDLER_DISPATCH);
+
+    DeviceState *device = this->getDevice(id, attrs);
+    if (device == NULL)
+        return;
+
+    // If the gesture is being classified buffer the frame
+    if (device->classifier.isActive()) {
+        if (device->classifier.getId() == id) {
+            device->classifier.addFrame(attrs, true);
+            this->classify(device, false);
+        }
+
     // If is an update of the current gesture execute it
-    if (this->currentGesture != NULL && this->currentGesture->getId() == id && !this->timerTap->isActive()) {
+    } else if (device->currentGesture != NULL && device->currentGesture->getId() == id) {
         qDebug() << "\tGesture Update" << id << type;
-        this->currentGesture->setAttrs(attrs);
-        this->currentGesture->update();
+        device->currentGesture->setAttrs(attrs);
+        device->currentGesture->update();
 
-    // If no gesture is running the gesture is a TAP, an unsupported gesture, or in Precise a DRAG
-    } else if (this->currentGesture == NULL) {
+    // If no gesture is running the gesture is a TAP, an unsupported gesture, or in Precise a DRAG, whose start has no
+    // movement and has not been classified
+    } else if (device->currentGesture == NULL) {
+        this->beginGesture(device, type, id, attrs, true);
+    }
 
-        Gesture *gesture = this->createGesture(type, id, attrs, false);
-        if (gesture != NULL) {
-            this->currentGesture = gesture;
+    this->watchGesture(device, id, attrs);
+}
 
-            // If the gesture is a tap allow to make a tap & hold
-            if (gesture->getType() == GestureTypeEnum::TAP) {
-                this->timerTap->start();
+void GestureHandler::executeGestureFinish(const QString &/*type*/, int id, const QHash<QString, QVariant>& attrs)
+{
+    LatencyStats::mark(LatencyStats::HANDLER_DISPATCH);
 
-            // In Precise the DeltaX and DeltaY attrs in start are 0. Create the Drag here
-            } else if (gesture->getType() == GestureTypeEnum::DRAG) {
-                qDebug() << "\tGesture Start";
-                this->currentGesture->start();
-                qDebug() << "\tGesture Update" << id << type;
-                this->currentGesture->update();
-            }
-        }
+    DeviceState *device = this->getDevice(id, attrs);
+    if (device == NULL)
+        return;
 
-    // If is an update with the timer running it is a DOUBLE_TAP or a TAP_AND_HOLD
-    } else if (this->currentGesture != NULL && this->timerTap->isActive()) {
-        this->timerTap->stop();
+    // If the gesture ends before it has been classified use the frames received
+    if (device->classifier.isActive() && device->classifier.getId() == id)
+        this->classify(device, true);
 
-        int currentNumFingers = this->currentGesture->getAttrs().value(GEIS_GESTURE_ATTRIBUTE_TOUCHES).toInt();
-        int newNumFingers     = attrs.value(GEIS_GESTURE_ATTRIBUTE_TOUCHES).toInt();
-        Gesture *gesture      = this->createGesture(type, id, attrs, true);
+    if (device->currentGesture != NULL && device->currentGesture->getId() == id) {
+        qDebug() << "\tGesture Finish";
+        device->currentGesture->setAttrs(attrs);
+        device->currentGesture->finish();
+        qDebug() << "\tX calls   -> " << XCalls::toString();
+        delete device->currentGesture;
+        device->currentGesture = NULL;
+    }
 
-        if (gesture != NULL && currentNumFingers == newNumFingers) {
+    this->watchGesture(device, id, attrs);
+}
 
-            // TAP_AND_HOLD
-            if (gesture->getType() == GestureTypeEnum::TAP_AND_HOLD) {
-                this->currentGesture = gesture;
 
-                qDebug() << "\tGesture Start";
-                this->currentGesture->start();
+// ****************************************************************************************************************** //
+// **********                                         PRIVATE SLOTS                                        ********** //
+// ****************************************************************************************************************** //
 
-                qDebug() << "\tGesture Update";
-                this->currentGesture->update();
+void GestureHandler::executeTap(int index)
+{
+    DeviceState *device = &this->devices[index];
+    this->recognizeTaps(device, TapStateMachine::TIMEOUT, QHash<QString, QVariant>());
+    this->watchGesture(device, device->tapId, QHash<QString, QVariant>());
+}
 
-            // DOUBLE_TAP
-            } else if (gesture->getType() == GestureTypeEnum::DOUBLE_TAP) {
-                this->currentGesture = gesture;
+void GestureHandler::cancelGesture(int index)
+{
+    DeviceState *device = &this->devices[index];
+    device->timerWatchdog->stop();
+    device->timerTap->stop();
+    device->taps.clear();
+    device->speculativeTaps = 0;
+    device->classifier.clear();
+
+    if (device->currentGesture != NULL) {
+        qDebug() << "\tGesture Cancel";
+        device->currentGesture->cancel();
+        delete device->currentGesture;
+        device->currentGesture = NULL;
+    }
 
-                qDebug() << "\tGesture Start";
-                this->currentGesture->start();
+    device->deviceId  = -1;
+    device->touchMask = 0;
+}
 
-                qDebug() << "\tGesture Update";
-                this->currentGesture->update();
 
-                qDebug() << "\tGesture Finish";
-                this->currentGesture->finish();
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void GestureHandler::beginGesture(DeviceState *device, const QString &type, int id,
+        const QHash<QString, QVariant>& attrs, bool isUpdate)
+{
+    // The taps are executed by the tap recognizer, that receives only the first frame of each tap
+    if (type == GEIS_GESTURE_TAP) {
+        if (id != device->tapId) {
+            device->tapId = id;
+            this->recognizeTaps(device, TapStateMachine::TAP, attrs);
+        }
+        return;
+    }
 
-                delete this->currentGesture;
-                this->currentGesture = NULL;
-            }
+    TapStateMachine::Output output = this->recognizeTaps(device,
+            type == GEIS_GESTURE_DRAG ? TapStateMachine::DRAG : TapStateMachine::OTHER, attrs);
 
+    // The direction of the drags and the TAP_AND_HOLDs is classified with the next frames
+    if (type == GEIS_GESTURE_DRAG) {
+        device->classifier.begin(type, id, output == TapStateMachine::HOLD);
+        device->classifier.addFrame(attrs, isUpdate);
+        this->classify(device, false);
+        return;
+    }
+
+    device->currentGesture = this->createGesture(device, type, id, attrs, false);
+    if (device->currentGesture != NULL) {
+        qDebug() << "\tGesture Start" << id << type;
+        device->currentGesture->start();
+
+        if (isUpdate) {
+            qDebug() << "\tGesture Update" << id << type;
+            device->currentGesture->update();
         }
     }
 }
 
-void GestureHandler::executeGestureFinish(const QString &/*type*/, int id, const QHash<QString, QVariant>& attrs)
+TapStateMachine::Output GestureHandler::recognizeTaps(DeviceState *device, TapStateMachine::Event event,
+        const QHash<QString, QVariant>& attrs)
 {
-    if (this->currentGesture != NULL && this->currentGesture->getId() == id) {
-        qDebug() << "\tGesture Finish";
-        this->currentGesture->setAttrs(attrs);
-        this->currentGesture->finish();
-        delete this->currentGesture;
-        this->currentGesture = NULL;
+    int numFingers = attrs.value(GEIS_GESTURE_ATTRIBUTE_TOUCHES).toInt();
+    TapStateMachine::Output ret = device->taps.next(event, numFingers, device->classifier.getTimestamp(attrs));
+    this->fireTaps(device);
+
+    if (event == TapStateMachine::TAP) {
+        int numTaps = device->taps.getNumTaps();
+
+        // The first tap of a sequence gives the window and the fingers of the gesture
+        if (numTaps == 1) {
+            XCalls::reset();
+            device->tapAttrs  = attrs;
+            device->tapWindow = this->getGestureWindow(attrs.value(GEIS_GESTURE_ATTRIBUTE_CHILD_WINDOW_ID).toInt());
+            device->tapApp    = this->getAppClass(device->tapWindow);
+        }
+
+        // If no composed gesture can follow don't wait for the next tap, else, if enabled, execute a tap whose
+        // action can run speculatively now
+        if (numTaps > 0 && !this->config->hasComposedGestures(device->tapApp, numFingers, numTaps)) {
+            device->taps.next(TapStateMachine::TIMEOUT, 0, 0);
+            this->fireTaps(device);
+        } else if (numTaps == 1 && this->config->isSpeculativeTapsEnabled()) {
+            if (this->executeTaps(device, 1, true))
+                device->speculativeTaps = 1;
+        }
     }
-}
 
+    // Wait for the next tap of the sequence
+    if (device->taps.getNumTaps() > 0)
+        device->timerTap->start();
+    else
+        device->timerTap->stop();
 
-// ****************************************************************************************************************** //
-// **********                                         PRIVATE SLOTS                                        ********** //
-// ****************************************************************************************************************** //
+    return ret;
+}
 
-void GestureHandler::executeTap()
+void GestureHandler::fireTaps(DeviceState *device)
 {
-    this->timerTap->stop();
+    int numTaps = device->taps.getFiredTaps();
+    if (numTaps == 0)
+        return;
 
-    if (this->currentGesture != NULL) {
-        qDebug() << "\tGesture Start";
-        this->currentGesture->start();
+    if (numTaps != device->speculativeTaps)
+        this->executeTaps(device, numTaps);
 
-        qDebug() << "\tGesture Update";
-        this->currentGesture->update();
+    device->speculativeTaps = 0;
+}
 
-        qDebug() << "\tGesture Finish";
-        this->currentGesture->finish();
+bool GestureHandler::executeTaps(DeviceState *device, int numTaps, bool onlySpeculative)
+{
+    Gesture *gesture = this->gestureFact->createTapGesture(numTaps, device->tapId, device->tapAttrs);
+    if (gesture == NULL)
+        return false;
 
-        delete this->currentGesture;
-        this->currentGesture = NULL;
+    this->assignAction(device, gesture, device->tapAttrs, device->tapWindow, device->tapApp);
+
+    if (onlySpeculative && (gesture->getAction() == NULL || !gesture->getAction()->canRunSpeculatively())) {
+        delete gesture;
+        return false;
     }
-}
 
+    qDebug() << "\tGesture Start";
+    gesture->start();
 
-// ****************************************************************************************************************** //
-// **********                                        PRIVATE METHODS                                       ********** //
-// ****************************************************************************************************************** //
+    qDebug() << "\tGesture Update";
+    gesture->update();
 
-Gesture *GestureHandler::createGesture(const QString &type, int id, const QHash<QString, QVariant>& attrs,
-    bool isComposedGesture) const
+    qDebug() << "\tGesture Finish";
+    gesture->finish();
+    qDebug() << "\tX calls   -> " << XCalls::toString();
+
+    delete gesture;
+    return true;
+}
+
+Gesture *GestureHandler::createGesture(const DeviceState *device, const QString &type, int id,
+    const QHash<QString, QVariant>& attrs, bool isComposedGesture) const
 {
     // Creamos el gesto sin su acción
     Gesture *ret;
@@ -181,104 +308,182 @@ Gesture *GestureHandler::createGesture(const QString &type, int id, const QHash<
         return NULL;
 
     // Vemos sobre que ventana se ha ejecutado
+    XCalls::reset();
     Window gestureWindow = this->getGestureWindow(attrs.value(GEIS_GESTURE_ATTRIBUTE_CHILD_WINDOW_ID).toInt());
     //if (gestureWindow == None)
     //    return NULL;
     QString appClass = this->getAppClass(gestureWindow);
 
-    // Creamos y asignamos la acción asociada al gesto
-    ActionTypeEnum::ActionType actionType = this->config->getAssociatedAction(appClass, ret->getType(),
-            ret->getNumFingers(), ret->getDirection());
-    QString actionSettings = this->config->getAssociatedSettings(appClass, ret->getType(), ret->getNumFingers(),
-            ret->getDirection());
-    QString timing = this->config->getAssociatedTiming(appClass, ret->getType(), ret->getNumFingers(),
-            ret->getDirection());
+    this->assignAction(device, ret, attrs, gestureWindow, appClass);
+    return ret;
+}
 
-    ret->setAction(this->actionFact->createAction(actionType, actionSettings, timing, gestureWindow));
+void GestureHandler::assignAction(const DeviceState *device, Gesture *gesture, const QHash<QString, QVariant>& attrs,
+        Window gestureWindow, const QString &appClass) const
+{
+    // Creamos y asignamos la acción asociada al gesto. Si es una diagonal sin acción se usa la del eje más cercano
+    GestureDirectionEnum::GestureDirection fallbackDir = GestureDirectionEnum::isDiagonal(gesture->getDirection())
+            ? GestureDirectionEnum::getDirection(attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_X).toFloat(),
+                    attrs.value(GEIS_GESTURE_ATTRIBUTE_DELTA_Y).toFloat(), 4)
+            : gesture->getDirection();
+    const MonitorInfo *monitor = MonitorCache::getInstance()->getGestureMonitor(attrs, device->direct);
+    const ActionConfig *actionConfig = this->config->getAssociatedConfig(appClass, gesture->getType(),
+            gesture->getNumFingers(), gesture->getDirection(), fallbackDir, device->profile,
+            (monitor != NULL) ? monitor->name : QString());
+    ActionTypeEnum::ActionType actionType = actionConfig != NULL ? actionConfig->type : ActionTypeEnum::NO_ACTION;
+    QString timing = actionConfig != NULL ? actionConfig->timing : "AT_END";
+
+    if (actionConfig != NULL) {
+        Action *action = this->actionFact->createAction(actionType, actionConfig->settings, timing, gestureWindow);
+        if (action != NULL) {
+            action->setUpdateStep(actionConfig->step, actionConfig->rate);
+            action->setGain(device->gain);
+            action->setMonitor(monitor);
+        }
+        gesture->setAction(action);
+    }
+    gesture->setActionType(actionType);
 
     // Mostramos los datos sobre el gesto
     qDebug() << "[+] New gesture:";
-    qDebug() << "\tType      -> " << GestureTypeEnum::getValue(ret->getType());
-    qDebug() << "\tFingers   -> " << ret->getNumFingers();
-    qDebug() << "\tDirection -> " << GestureDirectionEnum::getValue(ret->getDirection());
+    qDebug() << "\tType      -> " << GestureTypeEnum::getValue(gesture->getType());
+    qDebug() << "\tFingers   -> " << gesture->getNumFingers();
+    qDebug() << "\tDirection -> " << GestureDirectionEnum::getValue(gesture->getDirection());
     qDebug() << "\tAction    -> " << ActionTypeEnum::getValue(actionType);
     qDebug() << "\tTiming    -> " << timing;
     qDebug() << "\tApp Class -> " << appClass;
+    qDebug() << "\tMonitor   -> " << ((monitor != NULL) ? monitor->name : QString());
+    qDebug() << "\tX calls   -> " << XCalls::toString();
+}
 
-    return ret;
+GestureHandler::DeviceState *GestureHandler::getDevice(int id, const QHash<QString, QVariant>& attrs)
+{
+    int deviceId = attrs.value(GEIS_GESTURE_ATTRIBUTE_DEVICE_ID, 0).toInt();
+    quint64 touchMask = attrs.value(TOUCHEGG_GESTURE_ATTRIBUTE_TOUCH_MASK, 0).toULongLong();
+    DeviceState *overlappingDevice = NULL;
+    DeviceState *idleDevice = NULL;
+    DeviceState *freeDevice = NULL;
+
+    for (int n = 0; n < MAX_DEVICES; n++) {
+        DeviceState *device = &this->devices[n];
+        if (device->deviceId == -1) {
+            if (freeDevice == NULL)
+                freeDevice = device;
+            continue;
+        }
+
+        if (device->deviceId != deviceId)
+            continue;
+        if (this->isRunningGesture(device, id))
+            return device;
+
+        // Unknown touches overlap any gesture, so the gestures without touch IDs share the entry of their device. The
+        // entries waiting for a composed gesture take the new gestures, made with new touches
+        if (device->currentGesture == NULL && !device->classifier.isActive()) {
+            if (idleDevice == NULL)
+                idleDevice = device;
+        } else if (touchMask == 0 || device->touchMask == 0 || (touchMask & device->touchMask) != 0) {
+            if (overlappingDevice == NULL)
+                overlappingDevice = device;
+        }
+    }
+
+    if (overlappingDevice != NULL)
+        return overlappingDevice;
+    if (idleDevice != NULL)
+        return idleDevice;
+
+    if (freeDevice == NULL) {
+        qWarning("Ignoring gesture of device %d, too many devices with gestures running", deviceId);
+        return NULL;
+    }
+
+    // The settings of the device are looked up once per gesture, not per frame
+    const DeviceInfo *info = DeviceTable::getInstance()->getDevice(deviceId);
+    freeDevice->deviceId  = deviceId;
+    freeDevice->touchMask = 0;
+    freeDevice->profile   = (info != NULL) ? info->profile : QString();
+    freeDevice->gain      = (info != NULL) ? info->gain : 1;
+    freeDevice->direct    = (info != NULL) ? info->direct : false;
+    return freeDevice;
 }
 
-//------------------------------------------------------------------------------
+bool GestureHandler::isRunningGesture(const DeviceState *device, int id) const
+{
+    return (device->currentGesture != NULL && device->currentGesture->getId() == id)
+            || (device->classifier.isActive() && device->classifier.getId() == id);
+}
 
-Window GestureHandler::getGestureWindow(Window window) const
+void GestureHandler::classify(DeviceState *device, bool force)
 {
-    Window topIn = this->getTopLevelWindow(window);
-    if (topIn == None)
-        return None;
+    if (!force && !device->classifier.isReady())
+        return;
+
+    Gesture *gesture = this->createGesture(device, device->classifier.getType(), device->classifier.getId(),
+            device->classifier.getClassificationAttrs(), device->classifier.isComposed());
+
+    if (gesture != NULL) {
+        qDebug() << "\tClassified with" << device->classifier.getNumFrames() << "frames at"
+                << device->classifier.getVelocity() << "mm/ms";
+
+        // Replay the buffered frames
+        device->currentGesture = gesture;
+        for (int n = 0; n < device->classifier.getNumFrames(); n++) {
+            bool isUpdate;
+            device->currentGesture->setAttrs(device->classifier.getFrame(n, &isUpdate));
 
-    // Compare the top-level window of the specified window with the possible fake-top-level window (really they are not
-    // top-level windows, but are the windows that stores the attributes and more), returning the window that contains
-    // the title, the class...
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
-    long offset = 0;
-    long offsetSize = 100;
-
-    Window ret = None;
-
-    int status;
-    Atom atomList = XInternAtom(QX11Info::display(), "_NET_CLIENT_LIST_STACKING", false);
-    do {
-        status = XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(), atomList,
-                offset, offsetSize, false, XA_WINDOW, &atomRet, &size,
-                &numItems, &bytesAfterReturn, &propRet);
-
-        if (status == Success) {
-            Window *aux = (Window *)propRet;
-            unsigned int n = 0;
-            while (ret == None && n < numItems) {
-                // Check if the top-level window of the window of the list coincides with the window passed as argument
-                if (this->getTopLevelWindow(aux[n]) == topIn)
-                    ret = aux[n];
-                n++;
+            if (n == 0) {
+                qDebug() << "\tGesture Start";
+                device->currentGesture->start();
+            }
+            if (isUpdate) {
+                qDebug() << "\tGesture Update";
+                device->currentGesture->update();
             }
-            offset += offsetSize;
-            XFree(propRet);
         }
-    } while (status == Success && bytesAfterReturn != 0);
+    }
 
-    return ret;
+    device->classifier.clear();
 }
 
-Window GestureHandler::getTopLevelWindow(Window window) const
+void GestureHandler::watchGesture(DeviceState *device, int id, const QHash<QString, QVariant>& attrs)
 {
-    Window  root, parent;
-    Window *children;
-    unsigned int numChildren;
+    // Free the entry of the devices without gestures running nor waiting for a composed gesture
+    if (device->currentGesture == NULL && !device->classifier.isActive() && device->taps.getNumTaps() == 0) {
+        device->timerWatchdog->stop();
+        device->deviceId  = -1;
+        device->touchMask = 0;
+        return;
+    }
+
+    // The touches of the running gesture, kept if the frame has none, like the frames after the fingers are lifted
+    bool isRunningGesture = this->isRunningGesture(device, id);
+    quint64 touchMask = attrs.value(TOUCHEGG_GESTURE_ATTRIBUTE_TOUCH_MASK, 0).toULongLong();
+    if (isRunningGesture && touchMask != 0)
+        device->touchMask = touchMask;
 
-    if (XQueryTree(QX11Info::display(), window, &root, &parent, &children,
-            &numChildren) != 0) {
-        if (children != NULL)
-            XFree(children);
+    if (this->config->getGestureTimeout() == 0)
+        return;
 
-        if (parent == root)
-            return window;
-        else
-            return this->getTopLevelWindow(parent);
+    // Only the frames of the running gesture keep it alive
+    if (isRunningGesture || !device->timerWatchdog->isActive())
+        device->timerWatchdog->start();
+}
+
+//------------------------------------------------------------------------------
 
-    } else {
+Window GestureHandler::getGestureWindow(Window window) const
+{
+    Window topIn = XcbCalls::getTopLevelWindow(XConnection::display(), window);
+    if (topIn == None)
         return None;
-    }
+
+    // Return the client window (the window that contains the title, the class...) of the top-level window of the
+    // specified window, usually a frame created by the window manager
+    return RootWindowCache::getInstance()->getClientWindow(topIn);
 }
 
 QString GestureHandler::getAppClass(Window window) const
 {
-    XClassHint *classHint = XAllocClassHint();
-    XGetClassHint(QX11Info::display(), window, classHint);
-    QString ret = classHint->res_class;
-    XFree(classHint->res_class);
-    XFree(classHint->res_name);
-    return ret;
+    return XcbCalls::getWindowClass(XConnection::display(), window);
 }
@@ -23,11 +23,23 @@
 
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/config/Config.h"
+#include "src/touchegg/gestures/collector/GestureCollector.h"
 #include "src/touchegg/gestures/factory/GestureFactory.h"
+#include "src/touchegg/gestures/classifier/GestureClassifier.h"
+#include "src/touchegg/gestures/tap/TapStateMachine.h"
 #include "src/touchegg/actions/factory/ActionFactory.h"
+#include "src/touchegg/stats/LatencyStats.h"
+#include "src/touchegg/x11/XCalls.h"
+#include "src/touchegg/x11/XcbCalls.h"
+#include "src/touchegg/windows/RootWindowCache.h"
+#include "src/touchegg/devices/DeviceTable.h"
+#include "src/touchegg/monitors/MonitorCache.h"
 
 /**
- * Class that receives the gestures, processes it and execute the corresponding action.
+ * Class that receives the gestures, processes it and execute the corresponding action. The gestures of different
+ * touch devices are tracked at the same time, each device with its own composed gestures, classification and timeouts.
+ * The gestures made at the same time on a device with different fingers, for example with both hands on a
+ * touchscreen, are tracked independently too.
  */
 class GestureHandler : public QObject
 {
@@ -66,14 +78,137 @@ public slots:
 private slots:
 
     /**
-     * Run the taps that have not proven to be a composed gesture.
+     * Run the taps that have not been continued by other tap before the composed gestures time.
+     * @param index Index of the device in the table of devices.
      */
-    void executeTap();
+    void executeTap(int index);
+
+    /**
+     * Cancels the running gesture of a device, releasing the keys and buttons pressed by its action. Called when the
+     * gesture has not received frames for the configured time, because GEIS has not sent its end.
+     * @param index Index of the device in the table of devices.
+     */
+    void cancelGesture(int index);
 
 private:
 
+    /**
+     * Gestures of a touch device made with the same fingers.
+     */
+    struct DeviceState {
+        /**
+         * ID of the device, or -1 if the entry is free.
+         */
+        int deviceId;
+
+        /**
+         * Touches of the running gesture, see TOUCHEGG_GESTURE_ATTRIBUTE_TOUCH_MASK. 0 if unknown.
+         */
+        quint64 touchMask;
+
+        /**
+         * Name of the device settings, gain of the device and if it is a touchscreen, copied from the DeviceTable when
+         * the entry is taken.
+         */
+        QString profile;
+        float gain;
+        bool direct;
+
+        /**
+         * Gesture that is running.
+         */
+        Gesture *currentGesture;
+
+        /**
+         * Recognizer of the sequences of taps, the last tap ID sent to it and the attributes, the window and the
+         * application of the first tap of the sequence.
+         */
+        TapStateMachine taps;
+        int tapId;
+        QHash<QString, QVariant> tapAttrs;
+        Window tapWindow;
+        QString tapApp;
+
+        /**
+         * Number of taps of the sequence already executed speculatively, 0 or 1.
+         */
+        int speculativeTaps;
+
+        /**
+         * Timer that sends the TIMEOUT to the tap recognizer when no tap follows the pending ones.
+         */
+        QTimer *timerTap;
+
+        /**
+         * Timer that cancels the running gesture if it doesn't receive frames.
+         */
+        QTimer *timerWatchdog;
+
+        /**
+         * Classification window of the drags and tap & holds.
+         */
+        GestureClassifier classifier;
+    };
+
+    /**
+     * Returns the entry of a frame: the entry running the gesture of the frame, else an entry of its device running a
+     * gesture with some of its touches, else an entry of its device without gestures running, else a free entry.
+     * @param  id    Gesture ID.
+     * @param  attrs Gesture attributes.
+     * @return The entry or NULL if the table is full.
+     */
+    DeviceState *getDevice(int id, const QHash<QString, QVariant>& attrs);
+
+    /**
+     * Returns if a gesture is the one running, or being classified, in an entry.
+     * @param  device The entry.
+     * @param  id     Gesture ID.
+     * @return If it is running.
+     */
+    bool isRunningGesture(const DeviceState *device, int id) const;
+
+    /**
+     * Starts a gesture of a device without gestures running: sends the taps to the tap recognizer and starts the
+     * classification of the drags or the rest of gestures.
+     * @param device   The device of the gesture.
+     * @param type     Gesture type.
+     * @param id       Gesture ID.
+     * @param attrs    Gesture attributes.
+     * @param isUpdate If the frame is an update, false for the start frame.
+     */
+    void beginGesture(DeviceState *device, const QString &type, int id, const QHash<QString, QVariant>& attrs,
+            bool isUpdate);
+
+    /**
+     * Sends an event to the tap recognizer of a device, executing the taps that it fires. The taps that can't continue
+     * as a composed gesture are executed without waiting for the next one.
+     * @param  device The device.
+     * @param  event  The event.
+     * @param  attrs  Gesture attributes of the frame of the event.
+     * @return What to do with the frame.
+     */
+    TapStateMachine::Output recognizeTaps(DeviceState *device, TapStateMachine::Event event,
+            const QHash<QString, QVariant>& attrs);
+
+    /**
+     * Executes the TAP, DOUBLE_TAP or TRIPLE_TAP fired by the tap recognizer of a device, unless it has been executed
+     * speculatively.
+     * @param device The device.
+     */
+    void fireTaps(DeviceState *device);
+
+    /**
+     * Executes a TAP, DOUBLE_TAP or TRIPLE_TAP made with the first tap of the sequence of a device.
+     * @param  device          The device.
+     * @param  numTaps         Number of taps.
+     * @param  onlySpeculative Execute the gesture only if its action can run speculatively.
+     * @return If the gesture has been executed.
+     */
+    bool executeTaps(DeviceState *device, int numTaps, bool onlySpeculative = false);
+
     /**
      * Create a estandar gesture with their action.
+     * @param  device The device of the gesture.
      * @param  type  Gesture type.
      * @param  id    Gesture ID.
      * @param  attrs Gesture attributes, where the key is the name of the
@@ -83,8 +218,35 @@ private:
      *         tap) or not.
      * @return The gesture or NULL.
      */
-    Gesture *createGesture(const QString &type, int id, const QHash<QString, QVariant>& attrs,
-        bool isComposedGesture) const;
+    Gesture *createGesture(const DeviceState *device, const QString &type, int id,
+        const QHash<QString, QVariant>& attrs, bool isComposedGesture) const;
+
+    /**
+     * Assigns to a gesture the action configured for it in the window and the device where it has been made.
+     * @param device        The device of the gesture.
+     * @param gesture       The gesture.
+     * @param attrs         Gesture attributes.
+     * @param gestureWindow The window of the gesture.
+     * @param appClass      The class of the window.
+     */
+    void assignAction(const DeviceState *device, Gesture *gesture, const QHash<QString, QVariant>& attrs,
+            Window gestureWindow, const QString &appClass) const;
+
+    /**
+     * Creates the gesture being classified if the classifier is ready, starts it and replays the buffered frames.
+     * @param device The device of the gesture.
+     * @param force Classify the gesture even if the classifier is not ready, because the gesture has finished.
+     */
+    void classify(DeviceState *device, bool force);
+
+    /**
+     * Starts or restarts the watchdog that cancels the running gesture after a frame, or frees the entry of the
+     * device if it has no gestures running. Saves the touches of the frames of the running gesture.
+     * @param device The device of the gesture.
+     * @param id     ID of the gesture of the frame.
+     * @param attrs  Gesture attributes of the frame.
+     */
+    void watchGesture(DeviceState *device, int id, const QHash<QString, QVariant>& attrs);
 
     //------------------------------------------------------------------------------------------------------------------
 
@@ -95,13 +257,6 @@ private:
      */
     Window getGestureWindow(Window window) const;
 
-    /**
-     * Returns the top level window of the specified window.
-     * @param  window The window.
-     * @return This window.
-     */
-    Window getTopLevelWindow(Window window) const;
-
     /**
      * Returns the class of a window, for example, "XTerm" is the class of all instances of XTerm.
      * @param  window This window.
@@ -112,14 +267,23 @@ private:
     //------------------------------------------------------------------------------------------------------------------
 
     /**
-     * Gesture that is running.
+     * Maximum number of entries in use at the same time: devices with gestures running, plus the gestures made with
+     * other fingers at the same time on the same device.
+     */
+    static const int MAX_DEVICES = 8;
+
+    /**
+     * The entries of the devices with gestures running. Each entry runs one gesture at a time and the frames of other
+     * gesture IDs with some of its touches (GEIS recognizes several gestures with the same fingers) are ignored. The
+     * gestures of the same device with other fingers take their own entry.
      */
-    Gesture *currentGesture;
+    DeviceState devices[MAX_DEVICES];
 
     /**
-     * Timer that running the taps always that the gesture does not prove to be a composed gesture.
+     * Map the timeouts of the tap timers and the watchdogs to the index of their device.
      */
-    QTimer *timerTap;
+    QSignalMapper *tapMapper;
+    QSignalMapper *watchdogMapper;
 
     /**
      * Factory to create gestures.
@@ -30,14 +30,19 @@ Gesture::Gesture(GestureTypeEnum::GestureType type, int numFingers, GestureDirec
       numFingers(numFingers),
       dir(dir),
       id(id),
-      attrs(attrs)
+      attrs(attrs),
+      action(NULL),
+      actionType(ActionTypeEnum::NO_ACTION),
+      started(false)
 {
 
 }
 
 Gesture::~Gesture()
 {
-    delete this->action;
+    // The action could have pending commands in the injection thread
+    if (this->action != NULL)
+        ActionInjector::getInstance()->post(ActionInjector::DELETE_ACTION, this->action);
 }
 
 
@@ -47,20 +52,37 @@ Gesture::~Gesture()
 
 void Gesture::start() const
 {
+    // Several gestures can run at the same time, so the frame is attributed to the gesture that processes it
+    LatencyStats::setContext(this->type, this->actionType);
+    LatencyStats::mark(LatencyStats::GESTURE_EXECUTED);
+    this->started = true;
+
     if (this->action != NULL)
-        this->action->executeStart(this->attrs);
+        ActionInjector::getInstance()->post(ActionInjector::EXECUTE_START, this->action, this->attrs);
 }
 
 void Gesture::update() const
 {
+    LatencyStats::setContext(this->type, this->actionType);
+    LatencyStats::mark(LatencyStats::GESTURE_EXECUTED);
+
     if (this->action != NULL)
-        this->action->executeUpdate(this->attrs);
+        ActionInjector::getInstance()->post(ActionInjector::EXECUTE_UPDATE, this->action, this->attrs);
 }
 
 void Gesture::finish() const
 {
+    LatencyStats::setContext(this->type, this->actionType);
+    LatencyStats::mark(LatencyStats::GESTURE_EXECUTED);
+
     if (this->action != NULL)
-        this->action->executeFinish(this->attrs);
+        ActionInjector::getInstance()->post(ActionInjector::EXECUTE_FINISH, this->action, this->attrs);
+}
+
+void Gesture::cancel() const
+{
+    if (this->action != NULL && this->started)
+        ActionInjector::getInstance()->post(ActionInjector::EXECUTE_CANCEL, this->action);
 }
 
 
@@ -98,6 +120,11 @@ const Action *Gesture::getAction() const
     return this->action;
 }
 
+ActionTypeEnum::ActionType Gesture::getActionType() const
+{
+    return this->actionType;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 void Gesture::setType(GestureTypeEnum::GestureType type)
@@ -129,3 +156,8 @@ void Gesture::setAction(Action *action)
 {
     this->action = action;
 }
+
+void Gesture::setActionType(ActionTypeEnum::ActionType actionType)
+{
+    this->actionType = actionType;
+}
@@ -24,7 +24,10 @@
 #include "src/touchegg/util/Include.h"
 #include "src/touchegg/gestures/types/GestureTypeEnum.h"
 #include "src/touchegg/gestures/types/GestureDirectionEnum.h"
+#include "src/touchegg/actions/types/ActionTypeEnum.h"
 #include "src/touchegg/actions/implementation/Action.h"
+#include "src/touchegg/actions/injector/ActionInjector.h"
+#include "src/touchegg/stats/LatencyStats.h"
 
 /**
  * Class that should inherit all the gestures.
@@ -68,6 +71,11 @@ public:
      */
     void finish() const;
 
+    /**
+     * Is called instead of finish() when the gesture is aborted. Only cancels the action if it has been started.
+     */
+    void cancel() const;
+
     //------------------------------------------------------------------------------------------------------------------
 
     /**
@@ -106,6 +114,12 @@ public:
      */
     const Action *getAction() const;
 
+    /**
+     * Returns the type of the action configured for the gesture, used by the latency statistics.
+     * @return The type, NO_ACTION if none.
+     */
+    ActionTypeEnum::ActionType getActionType() const;
+
     //------------------------------------------------------------------------------------------------------------------
 
     /**
@@ -144,6 +158,12 @@ public:
      */
     void setAction(Action *action);
 
+    /**
+     * Sets the type of the action configured for the gesture.
+     * @param actionType The type.
+     */
+    void setActionType(ActionTypeEnum::ActionType actionType);
+
 private:
 
     /**
@@ -177,6 +197,16 @@ private:
      */
     Action *action;
 
+    /**
+     * Type of the action configured for the gesture.
+     */
+    ActionTypeEnum::ActionType actionType;
+
+    /**
+     * If start() has been called. Mutable because start() is const.
+     */
+    mutable bool started;
+
 };
 
 #endif // GESTURE_H
@@ -0,0 +1,140 @@
+/**
+ * @file /src/touchegg/gestures/tap/TapStateMachine.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TapStateMachine
+ */
+#include "TapStateMachine.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+const TapStateMachine::Transition TapStateMachine::TRANSITIONS[NUM_STATES][NUM_INPUTS] = {
+    // IDLE: a tap starts a sequence, the rest of gestures run normally
+    {
+        { ONE_TAP, 0, NONE },   // TAP_SAME_FINGERS
+        { ONE_TAP, 0, NONE },   // TAP_OTHER_FINGERS
+        { IDLE,    0, NONE },   // DRAG_SAME_FINGERS
+        { IDLE,    0, NONE },   // DRAG_OTHER_FINGERS
+        { IDLE,    0, NONE },   // OTHER_GESTURE
+        { IDLE,    0, NONE }    // TIMEOUT_EXPIRED
+    },
+    // ONE_TAP: waiting for a DOUBLE_TAP or a TAP_AND_HOLD
+    {
+        { TWO_TAPS, 0, NONE },  // TAP_SAME_FINGERS
+        { ONE_TAP,  1, NONE },  // TAP_OTHER_FINGERS
+        { IDLE,     0, HOLD },  // DRAG_SAME_FINGERS
+        { IDLE,     1, NONE },  // DRAG_OTHER_FINGERS
+        { IDLE,     1, NONE },  // OTHER_GESTURE
+        { IDLE,     1, NONE }   // TIMEOUT_EXPIRED
+    },
+    // TWO_TAPS: waiting for a TRIPLE_TAP, the longest sequence
+    {
+        { IDLE,    3, NONE },   // TAP_SAME_FINGERS
+        { ONE_TAP, 2, NONE },   // TAP_OTHER_FINGERS
+        { IDLE,    2, NONE },   // DRAG_SAME_FINGERS
+        { IDLE,    2, NONE },   // DRAG_OTHER_FINGERS
+        { IDLE,    2, NONE },   // OTHER_GESTURE
+        { IDLE,    2, NONE }    // TIMEOUT_EXPIRED
+    }
+};
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+TapStateMachine::TapStateMachine()
+    : state(IDLE),
+      numFingers(0),
+      lastTime(0),
+      firedTaps(0),
+      time(0) {}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+TapStateMachine::Output TapStateMachine::next(Event event, int numFingers, qint64 time)
+{
+    this->firedTaps = 0;
+
+    if (event == TIMEOUT)
+        return this->apply(TIMEOUT_EXPIRED, 0, 0);
+
+    // A frame received after the time doesn't continue the sequence, even if the owner has not sent the TIMEOUT yet
+    // because the event loop is busy. A timestamp older than the last tap comes from a different clock
+    if (this->state != IDLE && (time < this->lastTime || time - this->lastTime > this->time))
+        this->apply(TIMEOUT_EXPIRED, 0, 0);
+
+    bool sameFingers = (numFingers == this->numFingers);
+    Input input;
+    if (event == TAP)
+        input = sameFingers ? TAP_SAME_FINGERS : TAP_OTHER_FINGERS;
+    else if (event == DRAG)
+        input = sameFingers ? DRAG_SAME_FINGERS : DRAG_OTHER_FINGERS;
+    else
+        input = OTHER_GESTURE;
+
+    return this->apply(input, numFingers, time);
+}
+
+int TapStateMachine::getFiredTaps() const
+{
+    return this->firedTaps;
+}
+
+int TapStateMachine::getNumTaps() const
+{
+    return this->state;
+}
+
+void TapStateMachine::clear()
+{
+    this->state      = IDLE;
+    this->numFingers = 0;
+    this->firedTaps  = 0;
+}
+
+void TapStateMachine::setTime(int time)
+{
+    this->time = time;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+TapStateMachine::Output TapStateMachine::apply(Input input, int numFingers, qint64 time)
+{
+    const Transition &transition = TapStateMachine::TRANSITIONS[this->state][input];
+
+    // Only one transition of an event can fire taps, the second one always starts from IDLE
+    if (transition.firedTaps > 0)
+        this->firedTaps = transition.firedTaps;
+
+    if (input == TAP_SAME_FINGERS || input == TAP_OTHER_FINGERS) {
+        this->numFingers = numFingers;
+        this->lastTime   = time;
+    }
+
+    this->state = transition.next;
+    return transition.output;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file /src/touchegg/gestures/tap/TapStateMachine.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TapStateMachine
+ */
+#ifndef TAPSTATEMACHINE_H
+#define TAPSTATEMACHINE_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Recognizes the sequences of taps: TAP, DOUBLE_TAP, TRIPLE_TAP and the tap that starts a TAP_AND_HOLD.
+ *
+ * The machine is a table of transitions indexed by the state (the taps of the sequence waiting to be executed) and
+ * the received event. A tap continues the sequence if it has the same number of fingers and arrives before the
+ * composed gestures time, measured with the timestamps of the frames, and any other event ends it. The TIMEOUT event
+ * is sent by the owner when the time expires without frames.
+ *
+ * Each event runs in constant time and without allocations.
+ */
+class TapStateMachine
+{
+
+public:
+
+    /**
+     * Events received by the machine.
+     */
+    enum Event {
+        TAP,     ///< The first frame of a tap.
+        DRAG,    ///< The first frame of a drag.
+        OTHER,   ///< The first frame of any other gesture.
+        TIMEOUT  ///< The composed gestures time has expired without frames.
+    };
+
+    /**
+     * What the owner has to do with the frame of the event, besides executing the fired taps.
+     */
+    enum Output {
+        NONE,    ///< Nothing for the taps and the timeouts, run the gesture normally for the rest of events.
+        HOLD     ///< The drag is the second part of a TAP_AND_HOLD, the pending tap is consumed.
+    };
+
+    /**
+     * Creates a machine without taps.
+     */
+    TapStateMachine();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Sends an event to the machine.
+     * @param  event      The event.
+     * @param  numFingers Number of fingers of the gesture. Ignored by TIMEOUT.
+     * @param  time       Timestamp of the frame, in milliseconds. Ignored by TIMEOUT.
+     * @return What to do with the frame. The taps fired by the event are returned by getFiredTaps().
+     */
+    Output next(Event event, int numFingers, qint64 time);
+
+    /**
+     * Returns the number of taps of the sequence fired by the last event, that must be executed as a TAP, a DOUBLE_TAP
+     * or a TRIPLE_TAP, or 0 if the event has not fired any.
+     * @return The number of taps.
+     */
+    int getFiredTaps() const;
+
+    /**
+     * Returns the number of taps waiting for the next tap of the sequence.
+     * @return The number of taps, 0 if the machine is idle.
+     */
+    int getNumTaps() const;
+
+    /**
+     * Discards the pending taps.
+     */
+    void clear();
+
+    /**
+     * Sets the maximum time between two taps of a sequence.
+     * @param time The time in milliseconds.
+     */
+    void setTime(int time);
+
+private:
+
+    /**
+     * States of the machine, each one is the number of pending taps.
+     */
+    enum State {
+        IDLE,
+        ONE_TAP,
+        TWO_TAPS,
+        NUM_STATES
+    };
+
+    /**
+     * Events after comparing their fingers with the fingers of the pending taps.
+     */
+    enum Input {
+        TAP_SAME_FINGERS,
+        TAP_OTHER_FINGERS,
+        DRAG_SAME_FINGERS,
+        DRAG_OTHER_FINGERS,
+        OTHER_GESTURE,
+        TIMEOUT_EXPIRED,
+        NUM_INPUTS
+    };
+
+    /**
+     * Transition of the table.
+     */
+    struct Transition {
+        State next;
+        int firedTaps;
+        Output output;
+    };
+
+    /**
+     * Table of transitions.
+     */
+    static const Transition TRANSITIONS[NUM_STATES][NUM_INPUTS];
+
+    /**
+     * Applies the transition of the current state and the input.
+     * @param  input      The input.
+     * @param  numFingers Number of fingers of the gesture.
+     * @param  time       Timestamp of the frame.
+     * @return The output of the transition.
+     */
+    Output apply(Input input, int numFingers, qint64 time);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Current state, number of fingers and timestamp of the last tap of the sequence.
+     */
+    State state;
+    int numFingers;
+    qint64 lastTime;
+
+    /**
+     * Taps fired by the last event.
+     */
+    int firedTaps;
+
+    /**
+     * Maximum time between two taps.
+     */
+    int time;
+
+};
+
+#endif // TAPSTATEMACHINE_H
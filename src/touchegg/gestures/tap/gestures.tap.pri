@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/gestures/tap/TapStateMachine.h
+
+SOURCES += \
+    src/touchegg/gestures/tap/TapStateMachine.cpp
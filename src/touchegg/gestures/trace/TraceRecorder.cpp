@@ -0,0 +1,86 @@
+/**
+ * @file /src/touchegg/gestures/trace/TraceRecorder.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TraceRecorder
+ */
+#include "TraceRecorder.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+TraceRecorder::TraceRecorder(const QString &fileName)
+    : file(fileName)
+{
+    if (!this->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Can't open" << fileName << "to record the gestures";
+        return;
+    }
+
+    this->stream.setDevice(&this->file);
+    this->stream.setVersion(QDataStream::Qt_4_6);
+    this->stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    this->stream << TraceRecorder::MAGIC << TraceRecorder::VERSION;
+    this->timer.start();
+
+    qDebug() << "Recording gestures in" << fileName;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    this->file.close();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void TraceRecorder::record(EventType eventType, const QString &type, int id, const QHash<QString, QVariant>& attrs)
+{
+    if (!this->file.isOpen())
+        return;
+
+    this->stream << (quint8)eventType << (qint64)(this->timer.nsecsElapsed() / 1000) << (qint32)id << type
+                 << (quint16)attrs.size();
+
+    QHash<QString, QVariant>::const_iterator it;
+    for (it = attrs.constBegin(); it != attrs.constEnd(); ++it) {
+        this->stream << it.key();
+
+        const QVariant &value = it.value();
+        switch (value.type()) {
+        case QVariant::Bool:
+            this->stream << (quint8)ATTR_BOOL << value.toBool();
+            break;
+        case QVariant::Int:
+        case QVariant::UInt:
+            this->stream << (quint8)ATTR_INT << (qint32)value.toInt();
+            break;
+        case QVariant::ULongLong:
+            this->stream << (quint8)ATTR_WINDOW << value.toULongLong();
+            break;
+        case QVariant::String:
+            this->stream << (quint8)ATTR_STRING << value.toString();
+            break;
+        default:
+            this->stream << (quint8)ATTR_FLOAT << value.toFloat();
+            break;
+        }
+    }
+}
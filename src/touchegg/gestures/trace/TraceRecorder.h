@@ -0,0 +1,112 @@
+/**
+ * @file /src/touchegg/gestures/trace/TraceRecorder.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TraceRecorder
+ */
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Writes the GEIS gesture events to a compact binary trace file that can be played back later with TraceReplayer.
+ *
+ * The file starts with MAGIC and VERSION, followed by one record per event:
+ * - quint8  Event type (EventType).
+ * - qint64  Microseconds since the recording started.
+ * - qint32  Gesture ID.
+ * - QString Gesture class ("Drag", "Tap"...).
+ * - quint16 Number of attributes, followed by the name (QString), a type tag (AttrType) and the value of each one.
+ */
+class TraceRecorder
+{
+
+public:
+
+    /**
+     * Types of events stored in the trace.
+     */
+    enum EventType {
+        GESTURE_START,
+        GESTURE_UPDATE,
+        GESTURE_FINISH
+    };
+
+    /**
+     * Types of the attribute values stored in the trace.
+     */
+    enum AttrType {
+        ATTR_BOOL,
+        ATTR_INT,
+        ATTR_FLOAT,
+        ATTR_STRING,
+        ATTR_WINDOW
+    };
+
+    /**
+     * Identifier of the trace files.
+     */
+    static const quint32 MAGIC = 0x54454754; // "TEGT"
+
+    /**
+     * Version of the format of the trace files.
+     */
+    static const quint16 VERSION = 1;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Creates the trace file, overwriting it if it exists.
+     * @param fileName The file.
+     */
+    TraceRecorder(const QString &fileName);
+
+    /**
+     * Destructor. Closes the file.
+     */
+    ~TraceRecorder();
+
+    /**
+     * Appends an event to the trace.
+     * @param eventType Event type.
+     * @param type      Gesture type.
+     * @param id        Gesture ID.
+     * @param attrs     Gesture attributes.
+     */
+    void record(EventType eventType, const QString &type, int id, const QHash<QString, QVariant>& attrs);
+
+private:
+
+    /**
+     * File where the trace is saved.
+     */
+    QFile file;
+
+    /**
+     * Stream used to write the file.
+     */
+    QDataStream stream;
+
+    /**
+     * Time since the recording started.
+     */
+    QElapsedTimer timer;
+
+};
+
+#endif // TRACERECORDER_H
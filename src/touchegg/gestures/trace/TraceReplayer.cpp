@@ -0,0 +1,181 @@
+/**
+ * @file /src/touchegg/gestures/trace/TraceReplayer.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TraceReplayer
+ */
+#include "TraceReplayer.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+TraceReplayer::TraceReplayer(const QString &fileName, double speed, QObject *parent)
+    : QObject(parent),
+      nextEvent(0),
+      speed(speed),
+      eventTimer(new QTimer(this))
+{
+    this->eventTimer->setSingleShot(true);
+    connect(this->eventTimer, SIGNAL(timeout()), this, SLOT(playNextEvent()));
+
+    this->readTrace(fileName);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PUBLIC SLOTS                                         ********** //
+// ****************************************************************************************************************** //
+
+void TraceReplayer::start()
+{
+    qDebug() << "Replaying" << this->events.length() << "events";
+
+    this->nextEvent = 0;
+    this->timer.start();
+    this->scheduleNextEvent();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PRIVATE SLOTS                                        ********** //
+// ****************************************************************************************************************** //
+
+void TraceReplayer::playNextEvent()
+{
+    // Emit every event that is due, so a late timer doesn't accumulate delay. Playing as fast as possible, emit one
+    // event per iteration of the event loop to allow the composed gestures timer to run
+    qint64 elapsed = this->timer.nsecsElapsed() / 1000;
+    qint64 firstTimestamp = this->events.first().timestamp;
+
+    do {
+        const TraceEvent &event = this->events.at(this->nextEvent++);
+
+        switch (event.eventType) {
+        case TraceRecorder::GESTURE_START:
+            emit this->executeGestureStart(event.type, event.id, event.attrs);
+            break;
+        case TraceRecorder::GESTURE_UPDATE:
+            emit this->executeGestureUpdate(event.type, event.id, event.attrs);
+            break;
+        case TraceRecorder::GESTURE_FINISH:
+            emit this->executeGestureFinish(event.type, event.id, event.attrs);
+            break;
+        }
+    } while (this->nextEvent < this->events.length() && this->speed != 0
+            && (this->events.at(this->nextEvent).timestamp - firstTimestamp) / this->speed <= elapsed);
+
+    this->scheduleNextEvent();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void TraceReplayer::readTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Can't open the trace" << fileName;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_6);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic;
+    quint16 version;
+    stream >> magic >> version;
+    if (magic != TraceRecorder::MAGIC || version != TraceRecorder::VERSION) {
+        qWarning() << fileName << "is not a valid trace";
+        return;
+    }
+
+    while (!stream.atEnd() && stream.status() == QDataStream::Ok) {
+        TraceEvent event;
+        quint8 eventType;
+        qint32 id;
+        quint16 numAttrs;
+        stream >> eventType >> event.timestamp >> id >> event.type >> numAttrs;
+        event.eventType = (TraceRecorder::EventType)eventType;
+        event.id = id;
+
+        for (int n = 0; n < numAttrs; n++) {
+            QString name;
+            quint8 attrType;
+            stream >> name >> attrType;
+
+            switch (attrType) {
+            case TraceRecorder::ATTR_BOOL: {
+                bool value;
+                stream >> value;
+                event.attrs.insert(name, value);
+                break;
+            }
+            case TraceRecorder::ATTR_INT: {
+                qint32 value;
+                stream >> value;
+                event.attrs.insert(name, (int)value);
+                break;
+            }
+            case TraceRecorder::ATTR_WINDOW: {
+                qulonglong value;
+                stream >> value;
+                event.attrs.insert(name, value);
+                break;
+            }
+            case TraceRecorder::ATTR_STRING: {
+                QString value;
+                stream >> value;
+                event.attrs.insert(name, value);
+                break;
+            }
+            default: {
+                float value;
+                stream >> value;
+                event.attrs.insert(name, value);
+                break;
+            }
+            }
+        }
+
+        if (stream.status() == QDataStream::Ok)
+            this->events.append(event);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        qWarning() << "The trace" << fileName << "is truncated, replaying" << this->events.length() << "events";
+}
+
+void TraceReplayer::scheduleNextEvent()
+{
+    if (this->nextEvent >= this->events.length()) {
+        emit this->finished();
+        return;
+    }
+
+    if (this->speed == 0) {
+        this->eventTimer->start(0);
+    } else {
+        qint64 due = (qint64)((this->events.at(this->nextEvent).timestamp - this->events.first().timestamp)
+                / this->speed);
+        qint64 elapsed = this->timer.nsecsElapsed() / 1000;
+        this->eventTimer->start((int)qMax((qint64)0, (due - elapsed) / 1000));
+    }
+}
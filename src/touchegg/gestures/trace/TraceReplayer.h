@@ -0,0 +1,134 @@
+/**
+ * @file /src/touchegg/gestures/trace/TraceReplayer.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  TraceReplayer
+ */
+#ifndef TRACEREPLAYER_H
+#define TRACEREPLAYER_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/gestures/trace/TraceRecorder.h"
+
+/**
+ * Plays back a trace file written by TraceRecorder, emitting the same signals as GestureCollector. Allows to reproduce
+ * a gesture sequence without a touch device or uTouch.
+ */
+class TraceReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Reads the specified trace.
+     * @param fileName The trace file.
+     * @param speed    Playback speed: 1 plays at the recorded speed, 2 twice as fast... and 0 as fast as possible.
+     * @param parent   The parent of the class.
+     */
+    TraceReplayer(const QString &fileName, double speed, QObject *parent = 0);
+
+public slots:
+
+    /**
+     * Starts the playback.
+     */
+    void start();
+
+signals:
+
+    /**
+     * @see GestureCollector::executeGestureStart()
+     */
+    void executeGestureStart(const QString &type, int id, const QHash<QString, QVariant>& attrs);
+
+    /**
+     * @see GestureCollector::executeGestureUpdate()
+     */
+    void executeGestureUpdate(const QString &type, int id, const QHash<QString, QVariant>& attrs);
+
+    /**
+     * @see GestureCollector::executeGestureFinish()
+     */
+    void executeGestureFinish(const QString &type, int id, const QHash<QString, QVariant>& attrs);
+
+    /**
+     * Emitted when all the events have been played.
+     */
+    void finished();
+
+private slots:
+
+    /**
+     * Emits the next event and schedules the following one.
+     */
+    void playNextEvent();
+
+private:
+
+    /**
+     * An event read from the trace.
+     */
+    struct TraceEvent {
+        TraceRecorder::EventType eventType;
+        qint64 timestamp;
+        int id;
+        QString type;
+        QHash<QString, QVariant> attrs;
+    };
+
+    /**
+     * Reads all the events of the trace.
+     * @param fileName The trace file.
+     */
+    void readTrace(const QString &fileName);
+
+    /**
+     * Schedules the next event according to the recorded timestamps.
+     */
+    void scheduleNextEvent();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Events read from the trace.
+     */
+    QList<TraceEvent> events;
+
+    /**
+     * Index of the next event to play.
+     */
+    int nextEvent;
+
+    /**
+     * Playback speed.
+     */
+    double speed;
+
+    /**
+     * Time since the playback started.
+     */
+    QElapsedTimer timer;
+
+    /**
+     * Timer used to wait until the next event.
+     */
+    QTimer *eventTimer;
+
+};
+
+#endif // TRACEREPLAYER_H
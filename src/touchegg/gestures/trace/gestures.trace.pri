@@ -0,0 +1,7 @@
+HEADERS += \
+    src/touchegg/gestures/trace/TraceRecorder.h \
+    src/touchegg/gestures/trace/TraceReplayer.h
+
+SOURCES += \
+    src/touchegg/gestures/trace/TraceRecorder.cpp \
+    src/touchegg/gestures/trace/TraceReplayer.cpp
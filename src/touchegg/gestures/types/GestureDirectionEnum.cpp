@@ -40,3 +40,35 @@ GestureDirectionEnum::GestureDirection GestureDirectionEnum::getEnum(
     QMetaEnum metaEnum = GestureDirectionEnum.metaObject()->enumerator(index);
     return (GestureDirectionEnum::GestureDirection)metaEnum.keyToValue(gdString.toStdString().c_str());
 }
+
+GestureDirectionEnum::GestureDirection GestureDirectionEnum::getDirection(float deltaX, float deltaY,
+        int numDirections)
+{
+    // tan(22.5º), the limit between an axis and a diagonal
+    const float TAN_22_5 = 0.41421356f;
+
+    float absX = std::fabs(deltaX);
+    float absY = std::fabs(deltaY);
+
+    if (absX == 0 && absY == 0)
+        return GestureDirectionEnum::NO_DIRECTION;
+
+    if (numDirections == 8 && absX > TAN_22_5 * absY && absY > TAN_22_5 * absX) {
+        if (deltaY < 0)
+            return (deltaX < 0) ? GestureDirectionEnum::UP_LEFT : GestureDirectionEnum::UP_RIGHT;
+        else
+            return (deltaX < 0) ? GestureDirectionEnum::DOWN_LEFT : GestureDirectionEnum::DOWN_RIGHT;
+    }
+
+    // The exact diagonals are vertical with 4 directions
+    if (absY >= absX)
+        return (deltaY < 0) ? GestureDirectionEnum::UP : GestureDirectionEnum::DOWN;
+    else
+        return (deltaX < 0) ? GestureDirectionEnum::LEFT : GestureDirectionEnum::RIGHT;
+}
+
+bool GestureDirectionEnum::isDiagonal(GestureDirection dir)
+{
+    return dir == GestureDirectionEnum::UP_LEFT || dir == GestureDirectionEnum::UP_RIGHT
+            || dir == GestureDirectionEnum::DOWN_LEFT || dir == GestureDirectionEnum::DOWN_RIGHT;
+}
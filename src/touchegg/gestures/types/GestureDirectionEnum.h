@@ -45,7 +45,11 @@ public:
         LEFT,
         RIGHT,
         IN,
-        OUT
+        OUT,
+        UP_LEFT,
+        UP_RIGHT,
+        DOWN_LEFT,
+        DOWN_RIGHT
     };
 
     /**
@@ -60,6 +64,23 @@ public:
      */
     static GestureDirection getEnum(const QString &gtString);
 
+    /**
+     * Returns the direction of a movement. With 8 directions the movement is diagonal when its angle is closer to a
+     * diagonal than to an axis, checked comparing the deltas with tan(22.5º) instead of computing the angle.
+     * @param  deltaX        Horizontal movement.
+     * @param  deltaY        Vertical movement, positive downwards.
+     * @param  numDirections 4 (UP, DOWN, LEFT and RIGHT) or 8 (also the diagonals).
+     * @return The direction, NO_DIRECTION if there is no movement.
+     */
+    static GestureDirection getDirection(float deltaX, float deltaY, int numDirections);
+
+    /**
+     * Returns if a direction is a diagonal.
+     * @param  dir The direction.
+     * @return If it is a diagonal.
+     */
+    static bool isDiagonal(GestureDirection dir);
+
 };
 
 #endif // GESTUREDIRECTIONENUM_H
@@ -62,6 +62,9 @@ QStringList GestureTypeEnum::getGeisEquivalent(GestureType gt)
     case DOUBLE_TAP:
         return QStringList(GEIS_GESTURE_TAP);
 
+    case TRIPLE_TAP:
+        return QStringList(GEIS_GESTURE_TAP);
+
     default:
         return QStringList();
     }
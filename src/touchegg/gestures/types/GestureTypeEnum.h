@@ -43,7 +43,8 @@ public:
         PINCH,
         ROTATE,
         TAP_AND_HOLD,
-        DOUBLE_TAP
+        DOUBLE_TAP,
+        TRIPLE_TAP
     };
 
     /**
@@ -0,0 +1,210 @@
+/**
+ * @file /src/touchegg/launcher/CommandLauncher.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  CommandLauncher
+ */
+#include "CommandLauncher.h"
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    // Maximum size of a command, with the '\0' after each argument
+    const int MAX_COMMAND_SIZE = 64 * 1024;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+CommandLauncher *CommandLauncher::instance = NULL;
+
+CommandLauncher *CommandLauncher::getInstance()
+{
+    if (CommandLauncher::instance == NULL)
+        CommandLauncher::instance = new CommandLauncher();
+
+    return CommandLauncher::instance;
+}
+
+QStringList CommandLauncher::tokenize(const QString &command)
+{
+    QStringList arguments;
+    QString argument;
+    int quoteCount = 0;
+    bool inQuote = false;
+
+    for (int n = 0; n < command.size(); n++) {
+        if (command.at(n) == QLatin1Char('"')) {
+            quoteCount++;
+            if (quoteCount == 3) {
+                quoteCount = 0;
+                argument += command.at(n);
+            }
+            continue;
+        }
+
+        if (quoteCount > 0) {
+            if (quoteCount == 1)
+                inQuote = !inQuote;
+            quoteCount = 0;
+        }
+
+        if (!inQuote && command.at(n).isSpace()) {
+            if (!argument.isEmpty()) {
+                arguments.append(argument);
+                argument.clear();
+            }
+        } else {
+            argument += command.at(n);
+        }
+    }
+
+    if (!argument.isEmpty())
+        arguments.append(argument);
+
+    return arguments;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+CommandLauncher::CommandLauncher()
+    : launcherSocket(-1) {}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void CommandLauncher::start()
+{
+    if (this->launcherSocket != -1)
+        return;
+
+    // SOCK_SEQPACKET keeps the limits of the commands. Close-on-exec, so the commands don't inherit the sockets
+    int sockets[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == -1) {
+        qWarning("Couldn't create the socket of the command launcher: %s", strerror(errno));
+        return;
+    }
+
+    pid_t pid = ::fork();
+    if (pid == -1) {
+        qWarning("Couldn't start the command launcher: %s", strerror(errno));
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+        return;
+    }
+
+    if (pid == 0) {
+        ::close(sockets[0]);
+        CommandLauncher::runHelper(sockets[1]);
+        ::_exit(0);
+    }
+
+    ::close(sockets[1]);
+    this->launcherSocket = sockets[0];
+}
+
+bool CommandLauncher::launch(const QStringList &arguments)
+{
+    if (this->launcherSocket == -1 || arguments.isEmpty())
+        return false;
+
+    QByteArray packet;
+    foreach (const QString &argument, arguments)
+        packet.append(argument.toLocal8Bit()).append('\0');
+
+    if (packet.size() > MAX_COMMAND_SIZE)
+        return false;
+
+    if (::send(this->launcherSocket, packet.constData(), packet.size(), MSG_DONTWAIT | MSG_NOSIGNAL) == packet.size())
+        return true;
+
+    // The helper has exited, don't try again
+    if (errno == EPIPE || errno == ECONNRESET) {
+        qWarning("The command launcher is not running");
+        ::close(this->launcherSocket);
+        this->launcherSocket = -1;
+    }
+
+    return false;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void CommandLauncher::runHelper(int socket)
+{
+    // The commands are not waited for, and are reaped by the kernel
+    ::signal(SIGCHLD, SIG_IGN);
+
+    static char packet[MAX_COMMAND_SIZE + 1];
+    static char *argv[MAX_COMMAND_SIZE + 1];
+
+    // The commands don't inherit the ignored SIGCHLD
+    posix_spawnattr_t attributes;
+    sigset_t defaultSignals;
+    ::posix_spawnattr_init(&attributes);
+    ::sigemptyset(&defaultSignals);
+    ::sigaddset(&defaultSignals, SIGCHLD);
+    ::posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+    ::posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+
+    forever {
+        ssize_t size = ::recv(socket, packet, MAX_COMMAND_SIZE, 0);
+        if (size == -1 && errno == EINTR)
+            continue;
+
+        // Touchégg has exited
+        if (size <= 0)
+            break;
+
+        // Each argument ends with '\0'
+        packet[size] = '\0';
+        int argc = 0;
+        for (ssize_t n = 0; n < size; n += strlen(packet + n) + 1)
+            argv[argc++] = packet + n;
+        argv[argc] = NULL;
+
+        if (argc == 0)
+            continue;
+
+        pid_t pid;
+        int error = ::posix_spawnp(&pid, argv[0], NULL, &attributes, argv, environ);
+        if (error != 0)
+            fprintf(stderr, "Couldn't run the command \"%s\": %s\n", argv[0], strerror(error));
+    }
+
+    ::posix_spawnattr_destroy(&attributes);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file /src/touchegg/launcher/CommandLauncher.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  CommandLauncher
+ */
+#ifndef COMMANDLAUNCHER_H
+#define COMMANDLAUNCHER_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Runs the commands of the RUN_COMMAND actions from a helper process, forked when Touchégg starts and its address
+ * space is still small, so the commands are not forked from the whole application.
+ *
+ * The helper receives each command through a socketpair, as one packet with the arguments separated by '\0', and
+ * starts it with posix_spawnp() without waiting for it. Sending a command never blocks: if the helper is not running
+ * or can't receive it, launch() fails and the caller can run the command by itself.
+ */
+class CommandLauncher
+{
+
+public:
+
+    /**
+     * Returns the single instance of the class.
+     * @return The instance.
+     */
+    static CommandLauncher *getInstance();
+
+    /**
+     * Splits a command in arguments with the rules of QProcess: the arguments are separated by spaces, the arguments
+     * with spaces are quoted with double quotes and three consecutive double quotes are a literal double quote.
+     * @param  command The command.
+     * @return The program and its arguments.
+     */
+    static QStringList tokenize(const QString &command);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Forks the helper process. Must be called before creating any thread.
+     */
+    void start();
+
+    /**
+     * Sends a command to the helper. Must be called always from the same thread.
+     * @param  arguments The program and its arguments, see tokenize().
+     * @return If the command has been sent.
+     */
+    bool launch(const QStringList &arguments);
+
+private:
+
+    /**
+     * Main loop of the helper process: receives and starts commands until the socket is closed.
+     * @param socket The end of the socketpair of the helper.
+     */
+    static void runHelper(int socket);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * End of the socketpair of the application, -1 if the helper is not running.
+     */
+    int launcherSocket;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static CommandLauncher *instance;
+
+    // Hide constructors
+    CommandLauncher();
+    CommandLauncher(const CommandLauncher &);
+    const CommandLauncher &operator = (const CommandLauncher &);
+
+};
+
+#endif // COMMANDLAUNCHER_H
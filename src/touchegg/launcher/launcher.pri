@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/launcher/CommandLauncher.h
+
+SOURCES += \
+    src/touchegg/launcher/CommandLauncher.cpp
@@ -0,0 +1,201 @@
+/**
+ * @file /src/touchegg/monitors/MonitorCache.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  MonitorCache
+ */
+#include "MonitorCache.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+MonitorCache *MonitorCache::instance = NULL;
+
+MonitorCache *MonitorCache::getInstance()
+{
+    if (MonitorCache::instance == NULL)
+        MonitorCache::instance = new MonitorCache();
+
+    return MonitorCache::instance;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+MonitorCache::MonitorCache()
+    : QObject(),
+      screenPixelsPerMm(1),
+      eventBase(-1)
+{
+    Display *display = XConnection::display();
+    int errorBase;
+    if (XCalls::rrQueryExtension(display, &this->eventBase, &errorBase))
+        XCalls::rrSelectInput(display, XConnection::rootWindow(), RRScreenChangeNotifyMask);
+    else
+        this->eventBase = -1;
+
+    this->refresh();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+const QList<MonitorInfo> &MonitorCache::getMonitors() const
+{
+    return this->monitors;
+}
+
+QRect MonitorCache::getScreenGeometry() const
+{
+    return this->screenGeometry;
+}
+
+const MonitorInfo *MonitorCache::getMonitorAt(int x, int y) const
+{
+    int strip = qUpperBound(this->stripEdges.begin(), this->stripEdges.end(), x) - this->stripEdges.begin() - 1;
+    if (strip < 0 || strip >= this->stripMonitors.size())
+        return NULL;
+
+    foreach (int index, this->stripMonitors.at(strip)) {
+        if (this->monitors.at(index).geometry.contains(x, y))
+            return &this->monitors.at(index);
+    }
+
+    return NULL;
+}
+
+const MonitorInfo *MonitorCache::getGestureMonitor(const QHash<QString, QVariant>& attrs, bool direct) const
+{
+    // The bounding box of the touches of a touchpad is in device units, not in the screen
+    if (direct && attrs.contains(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_X1)
+            && attrs.contains(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_Y1)) {
+        float x = (attrs.value(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_X1).toFloat()
+                + attrs.value(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_X2).toFloat()) / 2;
+        float y = (attrs.value(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_Y1).toFloat()
+                + attrs.value(GEIS_GESTURE_ATTRIBUTE_BOUNDINGBOX_Y2).toFloat()) / 2;
+        return this->getMonitorAt((int)x, (int)y);
+    }
+
+    if (!attrs.contains(GEIS_GESTURE_ATTRIBUTE_FOCUS_X) || !attrs.contains(GEIS_GESTURE_ATTRIBUTE_FOCUS_Y))
+        return NULL;
+
+    return this->getMonitorAt(attrs.value(GEIS_GESTURE_ATTRIBUTE_FOCUS_X).toInt(),
+            attrs.value(GEIS_GESTURE_ATTRIBUTE_FOCUS_Y).toInt());
+}
+
+float MonitorCache::getPixelsPerMm(const MonitorInfo *monitor) const
+{
+    return (monitor != NULL) ? monitor->pixelsPerMm : this->screenPixelsPerMm;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PUBLIC SLOTS                                         ********** //
+// ****************************************************************************************************************** //
+
+void MonitorCache::x11Event(XEvent *event)
+{
+    if (this->eventBase < 0 || event->type != this->eventBase + RRScreenChangeNotify)
+        return;
+
+    // Updates the size of the screen returned by Xlib
+    XRRUpdateConfiguration(event);
+    this->refresh();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void MonitorCache::refresh()
+{
+    Display *display = XConnection::display();
+    int screen = XDefaultScreen(display);
+    this->monitors.clear();
+
+    // The X server always reports the physical size of the screen, calculated from its DPI if unknown
+    this->screenPixelsPerMm = (float)XDisplayWidth(display, screen) / qMax(1, XDisplayWidthMM(display, screen));
+
+    if (this->eventBase >= 0) {
+        int numMonitors = 0;
+        XRRMonitorInfo *info = XCalls::rrGetMonitors(display, XConnection::rootWindow(), True, &numMonitors);
+
+        for (int n = 0; n < numMonitors; n++) {
+            MonitorInfo monitor;
+            char *name = XCalls::getAtomName(display, info[n].name);
+            monitor.name     = (name != NULL) ? QString(name) : QString();
+            monitor.geometry    = QRect(info[n].x, info[n].y, info[n].width, info[n].height);
+            monitor.pixelsPerMm = (info[n].mwidth > 0) ? (float)info[n].width / info[n].mwidth
+                                                        : this->screenPixelsPerMm;
+            monitor.primary     = info[n].primary;
+            this->monitors.append(monitor);
+
+            if (name != NULL)
+                XFree(name);
+        }
+
+        if (info != NULL)
+            XRRFreeMonitors(info);
+    }
+
+    // Without XRandR, or if it doesn't report any monitor, the whole screen is one monitor
+    if (this->monitors.isEmpty()) {
+        MonitorInfo monitor;
+        monitor.geometry    = QRect(0, 0, XDisplayWidth(display, screen), XDisplayHeight(display, screen));
+        monitor.pixelsPerMm = this->screenPixelsPerMm;
+        monitor.primary     = true;
+        this->monitors.append(monitor);
+    }
+
+    this->screenGeometry = QRect();
+    foreach (const MonitorInfo &monitor, this->monitors)
+        this->screenGeometry = this->screenGeometry.united(monitor.geometry);
+
+    // Vertical strips, there are at most two edges per monitor
+    QList<int> edges;
+    foreach (const MonitorInfo &monitor, this->monitors)
+        edges << monitor.geometry.x() << monitor.geometry.x() + monitor.geometry.width();
+    qSort(edges);
+
+    this->stripEdges.clear();
+    this->stripMonitors.clear();
+    foreach (int edge, edges) {
+        if (!this->stripEdges.isEmpty() && this->stripEdges.last() == edge)
+            continue;
+
+        QList<int> stripMonitors;
+        for (int n = 0; n < this->monitors.size(); n++) {
+            const QRect &geometry = this->monitors.at(n).geometry;
+            if (geometry.x() <= edge && edge < geometry.x() + geometry.width())
+                stripMonitors.append(n);
+        }
+
+        this->stripEdges.append(edge);
+        this->stripMonitors.append(stripMonitors);
+    }
+
+    qDebug() << "[+] Monitors:";
+    foreach (const MonitorInfo &monitor, this->monitors)
+        qDebug() << "\t" << monitor.name << "->" << monitor.geometry << monitor.pixelsPerMm << "px/mm"
+                 << (monitor.primary ? "(primary)" : "");
+}
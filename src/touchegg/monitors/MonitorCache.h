@@ -0,0 +1,166 @@
+/**
+ * @file /src/touchegg/monitors/MonitorCache.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  MonitorCache
+ */
+#ifndef MONITORCACHE_H
+#define MONITORCACHE_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XConnection.h"
+#include "src/touchegg/x11/XCalls.h"
+
+/**
+ * A monitor, as reported by XRandR.
+ */
+struct MonitorInfo {
+    /**
+     * Name of the monitor, usually the name of its output (ie "HDMI-1").
+     */
+    QString name;
+
+    /**
+     * Position and size of the monitor in the X screen, in pixels.
+     */
+    QRect geometry;
+
+    /**
+     * Pixels per millimetre. If the monitor doesn't report its physical size, the ones of the X screen.
+     */
+    float pixelsPerMm;
+
+    /**
+     * If it is the primary monitor.
+     */
+    bool primary;
+};
+
+/**
+ * Mirror of the monitors of the X screen. The monitors are read with XRandR when the screen configuration changes
+ * (RRScreenChangeNotify), not every time an action needs them. Without XRandR the whole screen is a single monitor.
+ */
+class MonitorCache : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Returns the single instance of the class, reading the monitors the first time.
+     * @return The instance.
+     */
+    static MonitorCache *getInstance();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Returns the monitors. There is always at least one.
+     * @return The list.
+     */
+    const QList<MonitorInfo> &getMonitors() const;
+
+    /**
+     * Returns the rectangle that contains all the monitors, the size of the X screen that the window manager uses.
+     * @return The rectangle.
+     */
+    QRect getScreenGeometry() const;
+
+    /**
+     * Returns the monitor that contains a point. The monitors are looked up in the vertical strip of the screen that
+     * contains the point, found with a binary search.
+     * @param  x X coordinate of the point, in the X screen.
+     * @param  y Y coordinate of the point, in the X screen.
+     * @return The monitor or NULL if the point is outside all the monitors.
+     */
+    const MonitorInfo *getMonitorAt(int x, int y) const;
+
+    /**
+     * Returns the monitor where a gesture is made: the monitor under the center of the bounding box of the touches for
+     * the touchscreens and the monitor under the focus point, the cursor, for the touchpads.
+     * @param  attrs  Gesture attributes.
+     * @param  direct If the device of the gesture is a touchscreen.
+     * @return The monitor or NULL if it is not found.
+     */
+    const MonitorInfo *getGestureMonitor(const QHash<QString, QVariant>& attrs, bool direct) const;
+
+    /**
+     * Returns the pixels per millimetre of a monitor, used to convert between the millimetres of the gestures and the
+     * pixels of the screen in both directions.
+     * @param  monitor The monitor or NULL to use the X screen.
+     * @return The pixels per millimetre.
+     */
+    float getPixelsPerMm(const MonitorInfo *monitor) const;
+
+public slots:
+
+    /**
+     * Called whenever a X11 event occurs. Reads the monitors again when the screen configuration changes.
+     */
+    void x11Event(XEvent *event);
+
+private:
+
+    /**
+     * Reads the monitors.
+     */
+    void refresh();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * The monitors.
+     */
+    QList<MonitorInfo> monitors;
+
+    /**
+     * Rectangle that contains all the monitors.
+     */
+    QRect screenGeometry;
+
+    /**
+     * Pixels per millimetre of the X screen.
+     */
+    float screenPixelsPerMm;
+
+    /**
+     * The screen divided in vertical strips by the left and right edges of all the monitors: sorted X coordinates of
+     * the edges and indexes of the monitors of the strip that starts at each edge.
+     */
+    QVector<int> stripEdges;
+    QVector<QList<int> > stripMonitors;
+
+    /**
+     * First event of the XRandR extension, or -1 if the server doesn't support it.
+     */
+    int eventBase;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static MonitorCache *instance;
+
+    // Hide constructors
+    MonitorCache();
+    MonitorCache(const MonitorCache &);
+    const MonitorCache &operator = (const MonitorCache &);
+
+};
+
+#endif // MONITORCACHE_H
@@ -0,0 +1,5 @@
+HEADERS += \
+    src/touchegg/monitors/MonitorCache.h
+
+SOURCES += \
+    src/touchegg/monitors/MonitorCache.cpp
@@ -0,0 +1,109 @@
+/**
+ * @file /src/touchegg/stats/Histogram.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Histogram
+ */
+#include "Histogram.h"
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+Histogram::Histogram()
+    : count(0),
+      max(0)
+{
+    for (int n = 0; n < NUM_BUCKETS; n++)
+        this->buckets[n] = 0;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void Histogram::record(qint64 value)
+{
+    int v = (int)qBound((qint64)0, value, (qint64)INT_MAX);
+
+    this->buckets[Histogram::getBucketIndex(v)].fetchAndAddRelaxed(1);
+    this->count.fetchAndAddRelaxed(1);
+
+    int currentMax = this->max;
+    while (v > currentMax && !this->max.testAndSetRelaxed(currentMax, v))
+        currentMax = this->max;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                          GET/SET/IS                                          ********** //
+// ****************************************************************************************************************** //
+
+int Histogram::getCount() const
+{
+    return this->count;
+}
+
+qint64 Histogram::getPercentile(double percentile) const
+{
+    int total = this->count;
+    if (total == 0)
+        return 0;
+
+    qint64 target = qMax((qint64)1, (qint64)ceil(total * percentile / 100.0));
+    qint64 accumulated = 0;
+
+    for (int n = 0; n < NUM_BUCKETS; n++) {
+        accumulated += this->buckets[n];
+        if (accumulated >= target)
+            return qMin(Histogram::getBucketValue(n), this->getMax());
+    }
+
+    return this->getMax();
+}
+
+qint64 Histogram::getMax() const
+{
+    return this->max;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+int Histogram::getBucketIndex(int value)
+{
+    if (value < SUB_BUCKETS)
+        return value;
+
+    // The first SUB_BUCKETS values have a bucket each, from there every power of two is split in SUB_BUCKETS
+    int msb = 31 - __builtin_clz(value);
+    int shift = msb - SUB_BUCKETS_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+qint64 Histogram::getBucketValue(int index)
+{
+    if (index < SUB_BUCKETS)
+        return index;
+
+    int shift = index / SUB_BUCKETS - 1;
+    qint64 sub = index % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub) << shift) + ((qint64)1 << shift) - 1;
+}
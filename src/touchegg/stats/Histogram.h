@@ -0,0 +1,112 @@
+/**
+ * @file /src/touchegg/stats/Histogram.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  Histogram
+ */
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Lock-free log-linear histogram. Every power of two is split in SUB_BUCKETS linear buckets, so the relative error of
+ * the reported values is lower than 1/SUB_BUCKETS while the memory used is constant. Values can be recorded from any
+ * thread without locks.
+ */
+class Histogram
+{
+
+public:
+
+    /**
+     * Creates an empty histogram.
+     */
+    Histogram();
+
+    /**
+     * Records a value. Negative values are recorded as 0.
+     * @param value The value.
+     */
+    void record(qint64 value);
+
+    /**
+     * Returns the number of recorded values.
+     * @return The number of values.
+     */
+    int getCount() const;
+
+    /**
+     * Returns the value below which the indicated percentage of the recorded values falls.
+     * @param  percentile Percentile, between 0 and 100.
+     * @return The value, or 0 if the histogram is empty.
+     */
+    qint64 getPercentile(double percentile) const;
+
+    /**
+     * Returns the maximum recorded value.
+     * @return The value.
+     */
+    qint64 getMax() const;
+
+private:
+
+    /**
+     * Number of linear buckets per power of two (must be a power of two).
+     */
+    static const int SUB_BUCKETS_BITS = 3;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKETS_BITS;
+
+    /**
+     * Number of buckets needed to store any positive int.
+     */
+    static const int NUM_BUCKETS = (31 - SUB_BUCKETS_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * Returns the index of the bucket that stores the specified value.
+     * @param  value The value.
+     * @return The index.
+     */
+    static int getBucketIndex(int value);
+
+    /**
+     * Returns the highest value stored in the specified bucket.
+     * @param  index Index of the bucket.
+     * @return The value.
+     */
+    static qint64 getBucketValue(int index);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Number of values in each bucket.
+     */
+    QAtomicInt buckets[NUM_BUCKETS];
+
+    /**
+     * Number of recorded values.
+     */
+    QAtomicInt count;
+
+    /**
+     * Maximum recorded value.
+     */
+    QAtomicInt max;
+
+};
+
+#endif // HISTOGRAM_H
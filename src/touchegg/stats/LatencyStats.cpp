@@ -0,0 +1,231 @@
+/**
+ * @file /src/touchegg/stats/LatencyStats.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  LatencyStats
+ */
+#include "LatencyStats.h"
+#include <time.h>
+
+// ****************************************************************************************************************** //
+// **********                                      ANONYMOUS NAMESPACE                                     ********** //
+// ****************************************************************************************************************** //
+
+namespace
+{
+    /**
+     * If the calling thread is executing an action asynchronously and its context, see LatencyStats::beginInjection().
+     * The readyTime is set to 0 once the first injection has been recorded.
+     */
+    __thread bool injecting = false;
+    __thread LatencyStats::Context injectionContext = { 0, GestureTypeEnum::TAP, ActionTypeEnum::NO_ACTION };
+
+    const char *STAGE_NAMES[] = {
+        "Frame decoded   ",
+        "Handler dispatch",
+        "Gesture executed",
+        "First injection "
+    };
+
+    void printHistograms(QTextStream &out, const QString &title, const Histogram *histograms)
+    {
+        if (histograms[LatencyStats::GESTURE_EXECUTED].getCount() == 0)
+            return;
+
+        out << "\t" << title << "\n";
+        for (int stage = 0; stage < LatencyStats::NUM_STAGES; stage++) {
+            const Histogram &h = histograms[stage];
+            out << "\t\t" << STAGE_NAMES[stage]
+                << " -> n=" << h.getCount()
+                << " p50=" << h.getPercentile(50)
+                << " p99=" << h.getPercentile(99)
+                << " max=" << h.getMax() << "\n";
+        }
+    }
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+LatencyStats *LatencyStats::instance = NULL;
+
+void LatencyStats::enable()
+{
+    if (LatencyStats::instance == NULL)
+        LatencyStats::instance = new LatencyStats();
+}
+
+bool LatencyStats::isEnabled()
+{
+    return LatencyStats::instance != NULL;
+}
+
+void LatencyStats::eventsReady()
+{
+    if (LatencyStats::instance == NULL)
+        return;
+
+    LatencyStats::instance->readyTime = LatencyStats::now();
+    for (int n = 0; n < NUM_STAGES; n++)
+        LatencyStats::instance->stageLatency[n] = -1;
+}
+
+void LatencyStats::mark(Stage stage)
+{
+    LatencyStats *stats = LatencyStats::instance;
+    if (stats == NULL)
+        return;
+
+    // Actions executed in another thread. The histograms are atomic, so they can be recorded from here, but the state
+    // of the current frame belongs to the thread that processes the GEIS events
+    if (injecting) {
+        if (stage == FIRST_INJECTION && injectionContext.readyTime != 0) {
+            qint64 latency = LatencyStats::now() - injectionContext.readyTime;
+            int g = injectionContext.gestureType;
+            int a = injectionContext.actionType;
+            if (g >= 0 && g < MAX_GESTURE_TYPES && a >= 0 && a < MAX_ACTION_TYPES) {
+                stats->gestureHistograms[g][FIRST_INJECTION].record(latency);
+                stats->actionHistograms[a][FIRST_INJECTION].record(latency);
+            }
+            injectionContext.readyTime = 0;
+        }
+        return;
+    }
+
+    if (stats->readyTime == 0 || stats->stageLatency[stage] != -1)
+        return;
+
+    stats->stageLatency[stage] = LatencyStats::now() - stats->readyTime;
+}
+
+void LatencyStats::setContext(GestureTypeEnum::GestureType gestureType, ActionTypeEnum::ActionType actionType)
+{
+    if (LatencyStats::instance == NULL)
+        return;
+
+    LatencyStats::instance->gestureType = gestureType;
+    LatencyStats::instance->actionType  = actionType;
+}
+
+LatencyStats::Context LatencyStats::getContext()
+{
+    LatencyStats::Context ret = { 0, GestureTypeEnum::TAP, ActionTypeEnum::NO_ACTION };
+    LatencyStats *stats = LatencyStats::instance;
+    if (stats == NULL)
+        return ret;
+
+    ret.readyTime   = stats->readyTime;
+    ret.gestureType = stats->gestureType;
+    ret.actionType  = stats->actionType;
+    return ret;
+}
+
+void LatencyStats::beginInjection(const Context &context)
+{
+    if (LatencyStats::instance == NULL)
+        return;
+
+    injecting        = true;
+    injectionContext = context;
+}
+
+void LatencyStats::endInjection()
+{
+    injecting = false;
+    injectionContext.readyTime = 0;
+}
+
+void LatencyStats::eventProcessed()
+{
+    LatencyStats *stats = LatencyStats::instance;
+    if (stats == NULL || stats->readyTime == 0)
+        return;
+
+    // Only the frames that reach a gesture belong to a gesture/action type
+    int g = stats->gestureType;
+    int a = stats->actionType;
+    if (stats->stageLatency[GESTURE_EXECUTED] != -1 && g >= 0 && g < MAX_GESTURE_TYPES && a >= 0
+            && a < MAX_ACTION_TYPES) {
+        for (int stage = 0; stage < NUM_STAGES; stage++) {
+            if (stats->stageLatency[stage] != -1) {
+                stats->gestureHistograms[g][stage].record(stats->stageLatency[stage]);
+                stats->actionHistograms[a][stage].record(stats->stageLatency[stage]);
+            }
+        }
+    }
+
+    for (int n = 0; n < NUM_STAGES; n++)
+        stats->stageLatency[n] = -1;
+}
+
+void LatencyStats::eventsDone()
+{
+    if (LatencyStats::instance == NULL)
+        return;
+
+    LatencyStats::instance->readyTime = 0;
+}
+
+void LatencyStats::dump()
+{
+    LatencyStats *stats = LatencyStats::instance;
+    if (stats == NULL)
+        return;
+
+    QTextStream out(stderr);
+    out << "[+] Latency since the GEIS fd was readable (microseconds):\n";
+
+    for (int g = 0; g < MAX_GESTURE_TYPES; g++) {
+        printHistograms(out, "Gesture " + GestureTypeEnum::getValue((GestureTypeEnum::GestureType)g),
+                stats->gestureHistograms[g]);
+    }
+
+    for (int a = 0; a < MAX_ACTION_TYPES; a++) {
+        printHistograms(out, "Action " + ActionTypeEnum::getValue((ActionTypeEnum::ActionType)a),
+                stats->actionHistograms[a]);
+    }
+
+    out.flush();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+LatencyStats::LatencyStats()
+    : readyTime(0),
+      gestureType(GestureTypeEnum::TAP),
+      actionType(ActionTypeEnum::NO_ACTION)
+{
+    for (int n = 0; n < NUM_STAGES; n++)
+        this->stageLatency[n] = -1;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+qint64 LatencyStats::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (qint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
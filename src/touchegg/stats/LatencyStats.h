@@ -0,0 +1,190 @@
+/**
+ * @file /src/touchegg/stats/LatencyStats.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  LatencyStats
+ */
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/stats/Histogram.h"
+#include "src/touchegg/gestures/types/GestureTypeEnum.h"
+#include "src/touchegg/actions/types/ActionTypeEnum.h"
+
+/**
+ * Measures the time elapsed between the moment in which the GEIS file descriptor is readable and the different stages
+ * of the processing of each frame, recording it in a histogram per gesture type and per action type.
+ *
+ * The instrumentation is disabled by default and all the static methods return immediately in that case. It is
+ * enabled with the "--stats" command line option, see Touchegg.
+ */
+class LatencyStats
+{
+
+public:
+
+    /**
+     * Stages of the processing of a frame.
+     */
+    enum Stage {
+        FRAME_DECODED,
+        HANDLER_DISPATCH,
+        GESTURE_EXECUTED,
+        FIRST_INJECTION,
+        NUM_STAGES
+    };
+
+    /**
+     * Enables the instrumentation.
+     */
+    static void enable();
+
+    /**
+     * Returns if the instrumentation is enabled.
+     * @return true if it is enabled.
+     */
+    static bool isEnabled();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Called when the GEIS file descriptor is readable, before dispatching its events.
+     */
+    static void eventsReady();
+
+    /**
+     * Saves the time elapsed since eventsReady() for the current frame. Only the first call for each stage counts.
+     * @param stage The stage reached.
+     */
+    static void mark(Stage stage);
+
+    /**
+     * Sets the gesture and the action to which the current frame belongs. Called by the gesture that processes the
+     * frame, because gestures of several devices can run at the same time.
+     * @param gestureType The gesture type.
+     * @param actionType  The action type.
+     */
+    static void setContext(GestureTypeEnum::GestureType gestureType, ActionTypeEnum::ActionType actionType);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Frame and gesture/action to which an action executed asynchronously belongs.
+     */
+    struct Context {
+        qint64 readyTime;
+        GestureTypeEnum::GestureType gestureType;
+        ActionTypeEnum::ActionType   actionType;
+    };
+
+    /**
+     * Returns the context of the current frame, to be passed to another thread. readyTime is 0 if the instrumentation
+     * is disabled or there is not a frame in process.
+     * @return The context.
+     */
+    static Context getContext();
+
+    /**
+     * Called by the thread that executes the actions before executing a part of an action of the indicated context.
+     * Until endInjection() is called, the mark(FIRST_INJECTION) calls made in the calling thread are recorded directly
+     * in the histograms of the context.
+     * @param context The context.
+     */
+    static void beginInjection(const Context &context);
+
+    /**
+     * Called by the thread that executes the actions after executing a part of an action, see beginInjection().
+     */
+    static void endInjection();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Called after processing each GEIS event. Records the stages reached by the frame if it was used by a gesture.
+     */
+    static void eventProcessed();
+
+    /**
+     * Called when all the GEIS events have been processed.
+     */
+    static void eventsDone();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Prints p50/p99/max of every stage per gesture type and per action type.
+     */
+    static void dump();
+
+private:
+
+    /**
+     * Returns the monotonic time in microseconds.
+     * @return The time.
+     */
+    static qint64 now();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Maximum number of gesture and action types.
+     */
+    static const int MAX_GESTURE_TYPES = 16;
+    static const int MAX_ACTION_TYPES  = 32;
+
+    /**
+     * Time in which the GEIS file descriptor was readable or 0 outside of a frame.
+     */
+    qint64 readyTime;
+
+    /**
+     * Latency of each stage of the current frame or -1 if the stage has not been reached.
+     */
+    qint64 stageLatency[NUM_STAGES];
+
+    /**
+     * Gesture and action of the current frame.
+     */
+    GestureTypeEnum::GestureType gestureType;
+    ActionTypeEnum::ActionType   actionType;
+
+    /**
+     * Histograms per gesture type and stage.
+     */
+    Histogram gestureHistograms[MAX_GESTURE_TYPES][NUM_STAGES];
+
+    /**
+     * Histograms per action type and stage.
+     */
+    Histogram actionHistograms[MAX_ACTION_TYPES][NUM_STAGES];
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class, NULL if the instrumentation is disabled.
+     */
+    static LatencyStats *instance;
+
+    // Hide constructors
+    LatencyStats();
+    LatencyStats(const LatencyStats &);
+    const LatencyStats &operator = (const LatencyStats &);
+
+};
+
+#endif // LATENCYSTATS_H
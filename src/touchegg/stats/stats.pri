@@ -0,0 +1,7 @@
+HEADERS += \
+    src/touchegg/stats/Histogram.h \
+    src/touchegg/stats/LatencyStats.h
+
+SOURCES += \
+    src/touchegg/stats/Histogram.cpp \
+    src/touchegg/stats/LatencyStats.cpp
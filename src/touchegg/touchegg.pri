@@ -1,17 +1,27 @@
 include(util/util.pri)
 include(config/config.pri)
+include(stats/stats.pri)
+include(x11/x11.pri)
+include(eventloop/eventloop.pri)
 
 include(gestures/collector/gestures.collector.pri)
 include(gestures/handler/gestures.handler.pri)
+include(gestures/classifier/gestures.classifier.pri)
+include(gestures/tap/gestures.tap.pri)
 include(gestures/factory/gestures.factory.pri)
 include(gestures/implementation/gestures.implementation.pri)
 include(gestures/types/gestures.types.pri)
+include(gestures/trace/gestures.trace.pri)
 
 include(actions/types/actions.types.pri)
 include(actions/factory/actions.factory.pri)
+include(actions/injector/actions.injector.pri)
 include(actions/implementation/actions.implementation.pri)
 
 include(windows/windows.pri)
+include(devices/devices.pri)
+include(monitors/monitors.pri)
+include(launcher/launcher.pri)
 
 HEADERS += \
     src/touchegg/Touchegg.h
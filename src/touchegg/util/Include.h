@@ -22,15 +22,17 @@
 
     // Qt
     #include <QtCore>
-    #include <QtGui>
-    #include <QtGui/QX11Info>
-    #include <QtXml>
 
     // Xlib
     #include <X11/Xlib.h>
     #include <X11/Xutil.h>
     #include <X11/Xatom.h>
     #include <X11/extensions/XTest.h>
+    #include <X11/extensions/Xrandr.h>
+    #include <X11/Xlib-xcb.h>
+
+    // XCB
+    #include <xcb/xcb.h>
 
     // uTouch
     #include <geis/geis.h>
@@ -0,0 +1,178 @@
+/**
+ * @file /src/touchegg/windows/RootWindowCache.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  RootWindowCache
+ */
+#include "RootWindowCache.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+RootWindowCache *RootWindowCache::instance = NULL;
+
+RootWindowCache *RootWindowCache::getInstance()
+{
+    if (RootWindowCache::instance == NULL)
+        RootWindowCache::instance = new RootWindowCache();
+
+    return RootWindowCache::instance;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+RootWindowCache::RootWindowCache()
+    : QObject(),
+      numDesktops(0),
+      currentDesktop(0)
+{
+    this->refresh();
+    this->readDesktops();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+const QList<Window> &RootWindowCache::getStackingList() const
+{
+    return this->stackingList;
+}
+
+Window RootWindowCache::getClientWindow(Window topLevelWindow)
+{
+    QHash<Window, Window>::const_iterator it = this->clientWindows.constFind(topLevelWindow);
+    if (it != this->clientWindows.constEnd())
+        return it.value();
+
+    if (this->nonClientWindows.contains(topLevelWindow))
+        return None;
+
+    this->refresh();
+    Window clientWindow = this->clientWindows.value(topLevelWindow, None);
+    if (clientWindow == None)
+        this->nonClientWindows.insert(topLevelWindow);
+    return clientWindow;
+}
+
+void RootWindowCache::refresh()
+{
+    Display *display = XConnection::display();
+    QList<quint32> stacking = XcbCalls::getProperty(display, XConnection::rootWindow(), "_NET_CLIENT_LIST_STACKING",
+            XCB_ATOM_WINDOW);
+
+    // The frames of the windows already in the mirror don't change, only the new windows are queried
+    QList<Window> newWindows;
+    this->stackingList.clear();
+    foreach (quint32 window, stacking) {
+        this->stackingList.append(window);
+        if (!this->topLevelWindows.contains(window))
+            newWindows.append(window);
+    }
+
+    QHash<Window, Window> oldTopLevelWindows = this->topLevelWindows;
+    QHash<Window, Window> newTopLevelWindows = XcbCalls::getTopLevelWindows(display, newWindows);
+    this->topLevelWindows.clear();
+    this->clientWindows.clear();
+    this->nonClientWindows.clear();
+
+    // In stacking order, so if several clients share a frame the topmost one is used
+    foreach (Window window, this->stackingList) {
+        Window topLevelWindow = oldTopLevelWindows.contains(window)
+                ? oldTopLevelWindows.value(window)
+                : newTopLevelWindows.value(window, None);
+
+        this->topLevelWindows.insert(window, topLevelWindow);
+        if (topLevelWindow != None)
+            this->clientWindows.insert(topLevelWindow, window);
+    }
+}
+
+int RootWindowCache::getNumDesktops() const
+{
+    return this->numDesktops;
+}
+
+int RootWindowCache::getCurrentDesktop() const
+{
+    return this->currentDesktop;
+}
+
+QSize RootWindowCache::getDesktopGeometry() const
+{
+    return this->desktopGeometry;
+}
+
+QPoint RootWindowCache::getDesktopViewport() const
+{
+    return this->desktopViewports.value(this->currentDesktop, this->desktopViewports.value(0));
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PUBLIC SLOTS                                         ********** //
+// ****************************************************************************************************************** //
+
+void RootWindowCache::x11Event(XEvent *event)
+{
+    if (event->type != PropertyNotify)
+        return;
+
+    Display *display = XConnection::display();
+    if (event->xproperty.atom == XcbCalls::atom(display, "_NET_CLIENT_LIST_STACKING"))
+        this->refresh();
+    else if (event->xproperty.atom == XcbCalls::atom(display, "_NET_CURRENT_DESKTOP")
+            || event->xproperty.atom == XcbCalls::atom(display, "_NET_NUMBER_OF_DESKTOPS")
+            || event->xproperty.atom == XcbCalls::atom(display, "_NET_DESKTOP_GEOMETRY")
+            || event->xproperty.atom == XcbCalls::atom(display, "_NET_DESKTOP_VIEWPORT"))
+        this->readDesktops();
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void RootWindowCache::readDesktops()
+{
+    Display *display = XConnection::display();
+    xcb_get_property_cookie_t numberCookie = XcbCalls::requestProperty(display, XConnection::rootWindow(),
+            "_NET_NUMBER_OF_DESKTOPS", XCB_ATOM_CARDINAL, 1);
+    xcb_get_property_cookie_t currentCookie = XcbCalls::requestProperty(display, XConnection::rootWindow(),
+            "_NET_CURRENT_DESKTOP", XCB_ATOM_CARDINAL, 1);
+    xcb_get_property_cookie_t geometryCookie = XcbCalls::requestProperty(display, XConnection::rootWindow(),
+            "_NET_DESKTOP_GEOMETRY", XCB_ATOM_CARDINAL, 2);
+    xcb_get_property_cookie_t viewportCookie = XcbCalls::requestProperty(display, XConnection::rootWindow(),
+            "_NET_DESKTOP_VIEWPORT", XCB_ATOM_CARDINAL);
+    QList<quint32> number   = XcbCalls::propertyReply(display, numberCookie);
+    QList<quint32> current  = XcbCalls::propertyReply(display, currentCookie);
+    QList<quint32> geometry = XcbCalls::propertyReply(display, geometryCookie);
+    QList<quint32> viewport = XcbCalls::propertyReply(display, viewportCookie);
+
+    this->numDesktops     = number.isEmpty() ? 0 : number.first();
+    this->currentDesktop  = current.isEmpty() ? 0 : current.first();
+    this->desktopGeometry = (geometry.size() == 2) ? QSize(geometry.at(0), geometry.at(1)) : QSize();
+
+    this->desktopViewports.clear();
+    for (int n = 0; n + 1 < viewport.size(); n += 2)
+        this->desktopViewports.append(QPoint(viewport.at(n), viewport.at(n + 1)));
+}
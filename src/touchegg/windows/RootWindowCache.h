@@ -0,0 +1,156 @@
+/**
+ * @file /src/touchegg/windows/RootWindowCache.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  RootWindowCache
+ */
+#ifndef ROOTWINDOWCACHE_H
+#define ROOTWINDOWCACHE_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XConnection.h"
+#include "src/touchegg/x11/XcbCalls.h"
+
+/**
+ * Mirror of the _NET_CLIENT_LIST_STACKING property of the root window. The list is read in one request when it changes
+ * (PropertyNotify), not every time a gesture starts, and the top-level window (the frame added by the window manager)
+ * of each new client window is resolved once, so the client window of a frame is a hash lookup.
+ *
+ * The properties of the desktops (_NET_NUMBER_OF_DESKTOPS, _NET_CURRENT_DESKTOP, _NET_DESKTOP_GEOMETRY and
+ * _NET_DESKTOP_VIEWPORT) are mirrored in the same way.
+ */
+class RootWindowCache : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Returns the single instance of the class, reading the list the first time.
+     * @return The instance.
+     */
+    static RootWindowCache *getInstance();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Returns the client windows ordered from bottom to top.
+     * @return The list.
+     */
+    const QList<Window> &getStackingList() const;
+
+    /**
+     * Returns the client window contained in a top-level window. If the top-level window is not in the mirror, the
+     * list is read again in case the PropertyNotify of a new window has not been received yet. The windows still not
+     * found are remembered until the list changes, so they don't read it again.
+     * @param  topLevelWindow The top-level window.
+     * @return The client window or None if it doesn't contain any.
+     */
+    Window getClientWindow(Window topLevelWindow);
+
+    /**
+     * Reads the list again and resolves the top-level window of the new client windows. Forgets the top-level windows
+     * without client window.
+     */
+    void refresh();
+
+    /**
+     * Returns the number of desktops.
+     * @return The number, 0 if the window manager doesn't set it.
+     */
+    int getNumDesktops() const;
+
+    /**
+     * Returns the index of the current desktop.
+     * @return The index.
+     */
+    int getCurrentDesktop() const;
+
+    /**
+     * Returns the size of the desktops, that is bigger than the screen if the window manager uses viewports.
+     * @return The size, empty if the window manager doesn't set it.
+     */
+    QSize getDesktopGeometry() const;
+
+    /**
+     * Returns the top left corner of the viewport of the current desktop.
+     * @return The corner.
+     */
+    QPoint getDesktopViewport() const;
+
+public slots:
+
+    /**
+     * Called whenever a X11 event occurs. Refreshes the mirror when one of its properties changes.
+     */
+    void x11Event(XEvent *event);
+
+private:
+
+    /**
+     * Reads the properties of the desktops, all requested before waiting for the first reply.
+     */
+    void readDesktops();
+
+    /**
+     * _NET_CLIENT_LIST_STACKING.
+     */
+    QList<Window> stackingList;
+
+    /**
+     * Top-level window -> client window.
+     */
+    QHash<Window, Window> clientWindows;
+
+    /**
+     * Client window -> top-level window.
+     */
+    QHash<Window, Window> topLevelWindows;
+
+    /**
+     * Top-level windows without client window (desktop, panels, override-redirect windows...) found since the last
+     * refresh().
+     */
+    QSet<Window> nonClientWindows;
+
+    /**
+     * _NET_NUMBER_OF_DESKTOPS and _NET_CURRENT_DESKTOP.
+     */
+    int numDesktops;
+    int currentDesktop;
+
+    /**
+     * _NET_DESKTOP_GEOMETRY and _NET_DESKTOP_VIEWPORT, that has the viewport of each desktop.
+     */
+    QSize desktopGeometry;
+    QList<QPoint> desktopViewports;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static RootWindowCache *instance;
+
+    // Hide constructors
+    RootWindowCache();
+    RootWindowCache(const RootWindowCache &);
+    const RootWindowCache &operator = (const RootWindowCache &);
+
+};
+
+#endif // ROOTWINDOWCACHE_H
@@ -36,10 +36,25 @@ WindowListener::WindowListener(QObject *parent)
 // **********                                        PUBLIC METHODS                                        ********** //
 // ****************************************************************************************************************** //
 
+QList<Window> WindowListener::getClientList() const
+{
+    QList<Window> ret;
+    foreach (quint32 window, XcbCalls::getProperty(XConnection::display(), XConnection::rootWindow(),
+            "_NET_CLIENT_LIST", XCB_ATOM_WINDOW))
+        ret.append(window);
+
+    return ret;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PUBLIC SLOTS                                         ********** //
+// ****************************************************************************************************************** //
+
 void WindowListener::x11Event(XEvent *event)
 {
     if (event->type == PropertyNotify
-            && event->xproperty.atom == XInternAtom(QX11Info::display(), "_NET_CLIENT_LIST", false)) {
+            && event->xproperty.atom == XcbCalls::atom(XConnection::display(), "_NET_CLIENT_LIST")) {
         bool isNew;
         QList<Window> oldList = this->clientList;
         this->clientList = this->getClientList();
@@ -56,37 +71,6 @@ void WindowListener::x11Event(XEvent *event)
     }
 }
 
-QList<Window> WindowListener::getClientList() const
-{
-    Atom atomRet;
-    int size;
-    unsigned long numItems, bytesAfterReturn;
-    unsigned char *propRet;
-    long offset = 0;
-    long offsetSize = 100;
-    int status;
-    Atom atomList = XInternAtom(QX11Info::display(), "_NET_CLIENT_LIST", false);
-    QList<Window> ret;
-
-    do {
-        status = XGetWindowProperty(QX11Info::display(), QX11Info::appRootWindow(), atomList, offset, offsetSize, false,
-                XA_WINDOW, &atomRet, &size, &numItems, &bytesAfterReturn, &propRet);
-
-        if (status == Success) {
-            Window *aux = (Window *)propRet;
-            unsigned int n = 0;
-            while (n < numItems) {
-                ret.append(aux[n]);
-                n++;
-            }
-            offset += offsetSize;
-            XFree(propRet);
-        }
-    } while (status == Success && bytesAfterReturn != 0);
-
-    return ret;
-}
-
 
 // ****************************************************************************************************************** //
 // **********                                        PRIVATE METHODS                                       ********** //
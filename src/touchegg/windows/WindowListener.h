@@ -22,6 +22,7 @@
 #define WINDOWLISTENER_H
 
 #include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XcbCalls.h"
 
 /**
  * Detects the creation or destruction of the windows and emits the windowCreated or windowDeleted signals respectively.
@@ -40,18 +41,20 @@ public:
 
     //------------------------------------------------------------------------------------------------------------------
 
-    /**
-     * Called whenever a X11 event occurs. Is necessary to filter that event to know if is a creation or destruction of
-     * a window and emit the corresponding signals.
-     */
-    void x11Event(XEvent *event);
-
     /**
      * Returns the list of existing windows checking the _NET_CLIENT_LIST property set by the window manager.
      * @return The list.
      */
     QList<Window> getClientList() const;
 
+public slots:
+
+    /**
+     * Called whenever a X11 event occurs. Is necessary to filter that event to know if is a creation or destruction of
+     * a window and emit the corresponding signals.
+     */
+    void x11Event(XEvent *event);
+
 signals:
 
     /**
@@ -1,2 +1,7 @@
-HEADERS += src/touchegg/windows/WindowListener.h
-SOURCES += src/touchegg/windows/WindowListener.cpp
+HEADERS += \
+    src/touchegg/windows/WindowListener.h \
+    src/touchegg/windows/RootWindowCache.h
+
+SOURCES += \
+    src/touchegg/windows/WindowListener.cpp \
+    src/touchegg/windows/RootWindowCache.cpp
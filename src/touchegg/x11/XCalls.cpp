@@ -0,0 +1,52 @@
+/**
+ * @file /src/touchegg/x11/XCalls.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XCalls
+ */
+#include "XCalls.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+QAtomicInt XCalls::requests(0);
+QAtomicInt XCalls::roundTrips(0);
+QAtomicInt XCalls::flushes(0);
+
+void XCalls::reset()
+{
+    XCalls::requests.fetchAndStoreRelaxed(0);
+    XCalls::roundTrips.fetchAndStoreRelaxed(0);
+    XCalls::flushes.fetchAndStoreRelaxed(0);
+}
+
+XCalls::Counters XCalls::getCounters()
+{
+    XCalls::Counters ret;
+    ret.requests   = XCalls::requests.fetchAndAddRelaxed(0);
+    ret.roundTrips = XCalls::roundTrips.fetchAndAddRelaxed(0);
+    ret.flushes    = XCalls::flushes.fetchAndAddRelaxed(0);
+    return ret;
+}
+
+QString XCalls::toString()
+{
+    XCalls::Counters counters = XCalls::getCounters();
+    return QString("%1 requests, %2 round trips, %3 flushes").arg(counters.requests).arg(counters.roundTrips)
+            .arg(counters.flushes);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file /src/touchegg/x11/XCalls.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XCalls
+ */
+#ifndef XCALLS_H
+#define XCALLS_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/stats/LatencyStats.h"
+#include "src/touchegg/x11/XConnection.h"
+
+/**
+ * Thin wrappers around the Xlib and XTest calls that send requests to the X server. All the X requests of Touchégg
+ * should be made through this class.
+ *
+ * In debug builds the wrappers count the requests, the round trips (requests that wait for a reply) and the flushes,
+ * so GestureHandler can log the X traffic of each gesture. In release builds (QT_NO_DEBUG) the counters are compiled
+ * out and the wrappers are plain inline calls.
+ *
+ * The wrappers that inject input also mark the LatencyStats::FIRST_INJECTION stage.
+ */
+class XCalls
+{
+
+public:
+
+    /**
+     * X traffic counters.
+     */
+    struct Counters {
+        int requests;   ///< Requests sent, including the round trips.
+        int roundTrips; ///< Requests that wait for a reply.
+        int flushes;    ///< XFlush calls.
+    };
+
+    /**
+     * Sets all the counters to 0.
+     */
+    static void reset();
+
+    /**
+     * Returns the counters since the last reset(). Always 0 in release builds.
+     * @return The counters.
+     */
+    static Counters getCounters();
+
+    /**
+     * Returns the counters formatted to be logged, for example "12 requests, 3 round trips, 2 flushes".
+     * @return The counters.
+     */
+    static QString toString();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    static inline int flush(Display *display) {
+        XCalls::count(0, 0, 1);
+        return XFlush(display);
+    }
+
+    static inline Bool queryPointer(Display *display, Window window, Window *rootReturn, Window *childReturn,
+            int *rootXReturn, int *rootYReturn, int *winXReturn, int *winYReturn, unsigned int *maskReturn) {
+        XCalls::count(1, 1, 0);
+        return XQueryPointer(display, window, rootReturn, childReturn, rootXReturn, rootYReturn, winXReturn,
+                winYReturn, maskReturn);
+    }
+
+    static inline Status getWindowAttributes(Display *display, Window window,
+            XWindowAttributes *windowAttributesReturn) {
+        XCalls::count(1, 1, 0);
+        return XGetWindowAttributes(display, window, windowAttributesReturn);
+    }
+
+    static inline int resizeWindow(Display *display, Window window, unsigned int width, unsigned int height) {
+        XCalls::count(1, 0, 0);
+        return XResizeWindow(display, window, width, height);
+    }
+
+    static inline char *getAtomName(Display *display, Atom atom) {
+        XCalls::count(1, 1, 0);
+        return XGetAtomName(display, atom);
+    }
+
+    static inline Bool rrQueryExtension(Display *display, int *eventBaseReturn, int *errorBaseReturn) {
+        XCalls::count(1, 1, 0);
+        return XRRQueryExtension(display, eventBaseReturn, errorBaseReturn);
+    }
+
+    static inline void rrSelectInput(Display *display, Window window, int mask) {
+        XCalls::count(1, 0, 0);
+        XRRSelectInput(display, window, mask);
+    }
+
+    static inline XRRMonitorInfo *rrGetMonitors(Display *display, Window window, Bool getActive, int *numMonitors) {
+        XCalls::count(1, 1, 0);
+        return XRRGetMonitors(display, window, getActive, numMonitors);
+    }
+
+    static inline int testFakeKeyEvent(Display *display, unsigned int keycode, Bool isPress, unsigned long delay) {
+        LatencyStats::mark(LatencyStats::FIRST_INJECTION);
+        XCalls::count(1, 0, 0);
+        return XTestFakeKeyEvent(display, keycode, isPress, delay);
+    }
+
+    static inline int testFakeButtonEvent(Display *display, unsigned int button, Bool isPress, unsigned long delay) {
+        LatencyStats::mark(LatencyStats::FIRST_INJECTION);
+        XCalls::count(1, 0, 0);
+        return XTestFakeButtonEvent(display, button, isPress, delay);
+    }
+
+    static inline int testFakeRelativeMotionEvent(Display *display, int x, int y, unsigned long delay) {
+        LatencyStats::mark(LatencyStats::FIRST_INJECTION);
+        XCalls::count(1, 0, 0);
+        return XTestFakeRelativeMotionEvent(display, x, y, delay);
+    }
+
+private:
+
+    // The XCB requests are counted in the same counters
+    friend class XcbCalls;
+
+    static inline void count(int requests, int roundTrips, int flushes) {
+#ifndef QT_NO_DEBUG
+        XCalls::requests.fetchAndAddRelaxed(requests);
+        XCalls::roundTrips.fetchAndAddRelaxed(roundTrips);
+        XCalls::flushes.fetchAndAddRelaxed(flushes);
+#else
+        Q_UNUSED(requests);
+        Q_UNUSED(roundTrips);
+        Q_UNUSED(flushes);
+#endif
+    }
+
+    /**
+     * The counters. Only used in debug builds. Atomic because the actions are executed in the ActionInjector thread.
+     */
+    static QAtomicInt requests;
+    static QAtomicInt roundTrips;
+    static QAtomicInt flushes;
+
+};
+
+#endif // XCALLS_H
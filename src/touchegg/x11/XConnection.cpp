@@ -0,0 +1,132 @@
+/**
+ * @file /src/touchegg/x11/XConnection.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XConnection
+ */
+#include "XConnection.h"
+#include "src/touchegg/eventloop/EpollEventDispatcher.h"
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+XConnection *XConnection::instance = NULL;
+
+XConnection *XConnection::getInstance()
+{
+    if (XConnection::instance == NULL)
+        XConnection::instance = new XConnection();
+
+    return XConnection::instance;
+}
+
+Display *XConnection::display()
+{
+    return XConnection::getInstance()->xDisplay;
+}
+
+Window XConnection::rootWindow()
+{
+    return XConnection::getInstance()->root;
+}
+
+int XConnection::screenWidth()
+{
+    return XConnection::getInstance()->width;
+}
+
+int XConnection::screenHeight()
+{
+    return XConnection::getInstance()->height;
+}
+
+void XConnection::installErrorHandler()
+{
+    static bool installed = false;
+    if (installed)
+        return;
+
+    XSetErrorHandler(XConnection::errorHandler);
+    installed = true;
+}
+
+int XConnection::errorHandler(Display *display, XErrorEvent *error)
+{
+    char text[256];
+    XGetErrorText(display, error->error_code, text, sizeof(text));
+    qWarning("X error: %s (request %d.%d, resource 0x%lx)", text, error->request_code, error->minor_code,
+            error->resourceid);
+    return 0;
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                  CONSTRUCTORS AND DESTRUCTOR                                 ********** //
+// ****************************************************************************************************************** //
+
+XConnection::XConnection()
+    : QObject(),
+      notifier(NULL)
+{
+    XConnection::installErrorHandler();
+    this->xDisplay = XOpenDisplay(NULL);
+    if (this->xDisplay == NULL)
+        qFatal("Couldn't connect to the X server");
+
+    int screen   = XDefaultScreen(this->xDisplay);
+    this->root   = XRootWindow(this->xDisplay, screen);
+    this->width  = XDisplayWidth(this->xDisplay, screen);
+    this->height = XDisplayHeight(this->xDisplay, screen);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PUBLIC METHODS                                        ********** //
+// ****************************************************************************************************************** //
+
+void XConnection::listen()
+{
+    if (this->notifier != NULL)
+        return;
+
+    // Needed by WindowListener to know when a window is created or destroyed
+    XSelectInput(this->xDisplay, this->root, PropertyChangeMask);
+    XFlush(this->xDisplay);
+
+    this->notifier = new QSocketNotifier(XConnectionNumber(this->xDisplay), QSocketNotifier::Read, this);
+    EpollEventDispatcher::setSocketPriority(XConnectionNumber(this->xDisplay), EpollEventDispatcher::X_PRIORITY);
+    connect(this->notifier, SIGNAL(activated(int)), this, SLOT(readEvents()));
+
+    // The replies read by Xlib can bring events with them, leaving them queued without the file descriptor being
+    // readable, so check the queue every time the event loop is going to wait
+    connect(QAbstractEventDispatcher::instance(), SIGNAL(aboutToBlock()), this, SLOT(readEvents()));
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                         PRIVATE SLOTS                                        ********** //
+// ****************************************************************************************************************** //
+
+void XConnection::readEvents()
+{
+    while (XPending(this->xDisplay) > 0) {
+        XEvent event;
+        XNextEvent(this->xDisplay, &event);
+        emit this->eventReceived(&event);
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ * @file /src/touchegg/x11/XConnection.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XConnection
+ */
+#ifndef XCONNECTION_H
+#define XCONNECTION_H
+
+#include "src/touchegg/util/Include.h"
+
+/**
+ * Connection of the main thread to the X server. Replaces QApplication and QX11Info, so Touchégg doesn't need QtGui.
+ *
+ * The connection is opened the first time it is used. Its events are only read after calling listen(): the connection
+ * file descriptor is watched by the Qt event loop and every event read is emitted with the eventReceived() signal.
+ */
+class XConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Returns the single instance of the class, opening the connection if necessary.
+     * @return The instance.
+     */
+    static XConnection *getInstance();
+
+    /**
+     * Returns the connection to the X server.
+     * @return The display.
+     */
+    static Display *display();
+
+    /**
+     * Returns the root window of the default screen.
+     * @return The root window.
+     */
+    static Window rootWindow();
+
+    /**
+     * Returns the size, in pixels, of the default screen.
+     * @return The size.
+     */
+    static int screenWidth();
+    static int screenHeight();
+
+    /**
+     * Installs the handler of the X protocol errors, that logs them instead of exiting like the default handler of
+     * Xlib. The handler is shared by all the connections, so it is installed once, before the first connection is
+     * opened. Errors are expected, for example a BadWindow when a window is closed during a gesture.
+     */
+    static void installErrorHandler();
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Starts reading the events of the connection and selects the property changes of the root window.
+     */
+    void listen();
+
+signals:
+
+    /**
+     * Emitted for every event received. The event is only valid while the signal is being emitted.
+     * @param event The event.
+     */
+    void eventReceived(XEvent *event);
+
+private slots:
+
+    /**
+     * Emits all the events read from the connection or already queued by Xlib.
+     */
+    void readEvents();
+
+private:
+
+    /**
+     * Handler of the X protocol errors.
+     * @param  display The connection that received the error.
+     * @param  error   The error.
+     * @return Ignored by Xlib.
+     */
+    static int errorHandler(Display *display, XErrorEvent *error);
+
+    /**
+     * The connection.
+     */
+    Display *xDisplay;
+
+    /**
+     * Root window and size of the default screen.
+     */
+    Window root;
+    int width;
+    int height;
+
+    /**
+     * Watches the connection file descriptor, NULL until listen() is called.
+     */
+    QSocketNotifier *notifier;
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Single instance of the class.
+     */
+    static XConnection *instance;
+
+    // Hide constructors
+    XConnection();
+    XConnection(const XConnection &);
+    const XConnection &operator = (const XConnection &);
+
+};
+
+#endif // XCONNECTION_H
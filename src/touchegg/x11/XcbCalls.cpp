@@ -0,0 +1,203 @@
+/**
+ * @file /src/touchegg/x11/XcbCalls.cpp
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XcbCalls
+ */
+#include "XcbCalls.h"
+#include "src/touchegg/x11/XConnection.h"
+#include <cstdlib>
+#include <cstring>
+
+// ****************************************************************************************************************** //
+// **********                                 STATIC METHODS AND VARIABLES                                 ********** //
+// ****************************************************************************************************************** //
+
+QHash<QByteArray, xcb_atom_t> XcbCalls::atoms;
+QMutex XcbCalls::atomsMutex;
+
+xcb_connection_t *XcbCalls::connection(Display *display)
+{
+    return XGetXCBConnection(display);
+}
+
+xcb_atom_t XcbCalls::atom(Display *display, const char *name)
+{
+    QMutexLocker locker(&XcbCalls::atomsMutex);
+    QHash<QByteArray, xcb_atom_t>::const_iterator it = XcbCalls::atoms.constFind(name);
+    if (it != XcbCalls::atoms.constEnd())
+        return it.value();
+
+    xcb_connection_t *c = XcbCalls::connection(display);
+    XCalls::count(1, 1, 0);
+    xcb_generic_error_t *error = NULL;
+    xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(c, xcb_intern_atom(c, false, strlen(name), name), &error);
+    XcbCalls::checkError(error, "InternAtom");
+    if (reply == NULL)
+        return XCB_ATOM_NONE;
+
+    xcb_atom_t ret = reply->atom;
+    free(reply);
+    XcbCalls::atoms.insert(name, ret);
+    return ret;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+xcb_get_property_cookie_t XcbCalls::requestProperty(Display *display, Window window, const char *name,
+        xcb_atom_t type, quint32 length)
+{
+    XCalls::count(1, 0, 0);
+    return xcb_get_property(XcbCalls::connection(display), false, window, XcbCalls::atom(display, name), type, 0,
+            length);
+}
+
+QList<quint32> XcbCalls::propertyReply(Display *display, xcb_get_property_cookie_t cookie)
+{
+    XCalls::count(0, 1, 0);
+    xcb_generic_error_t *error = NULL;
+    xcb_get_property_reply_t *reply = xcb_get_property_reply(XcbCalls::connection(display), cookie, &error);
+    XcbCalls::checkError(error, "GetProperty");
+
+    QList<quint32> ret;
+    if (reply == NULL)
+        return ret;
+
+    if (reply->format == 32) {
+        const quint32 *values = (const quint32 *)xcb_get_property_value(reply);
+        int numValues = xcb_get_property_value_length(reply) / 4;
+        for (int n = 0; n < numValues; n++)
+            ret.append(values[n]);
+    }
+
+    free(reply);
+    return ret;
+}
+
+QList<quint32> XcbCalls::getProperty(Display *display, Window window, const char *name, xcb_atom_t type)
+{
+    return XcbCalls::propertyReply(display, XcbCalls::requestProperty(display, window, name, type));
+}
+
+QString XcbCalls::getWindowClass(Display *display, Window window)
+{
+    xcb_connection_t *c = XcbCalls::connection(display);
+    XCalls::count(1, 1, 0);
+    xcb_generic_error_t *error = NULL;
+    xcb_get_property_reply_t *reply = xcb_get_property_reply(c,
+            xcb_get_property(c, false, window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, 256), &error);
+    XcbCalls::checkError(error, "GetProperty");
+
+    QString ret;
+    if (reply == NULL)
+        return ret;
+
+    // WM_CLASS contains two consecutive null-terminated strings, the instance name and the class
+    const char *value = (const char *)xcb_get_property_value(reply);
+    int length = xcb_get_property_value_length(reply);
+    int nameLength = qstrnlen(value, length);
+    if (nameLength + 1 < length)
+        ret = QString::fromLocal8Bit(value + nameLength + 1, qstrnlen(value + nameLength + 1, length - nameLength - 1));
+
+    free(reply);
+    return ret;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+QHash<Window, Window> XcbCalls::getTopLevelWindows(Display *display, const QList<Window> &windows)
+{
+    xcb_connection_t *c = XcbCalls::connection(display);
+    QHash<Window, Window> ret;
+
+    // Window whose top-level window is being looked for -> window to query in the current level
+    QHash<Window, Window> pending;
+    foreach (Window window, windows)
+        pending.insert(window, window);
+
+    while (!pending.isEmpty()) {
+        QList<Window> keys = pending.keys();
+        QVector<xcb_query_tree_cookie_t> cookies(keys.size());
+        for (int n = 0; n < keys.size(); n++)
+            cookies[n] = xcb_query_tree(c, pending.value(keys.at(n)));
+        XCalls::count(keys.size(), 1, 0);
+
+        QHash<Window, Window> next;
+        for (int n = 0; n < keys.size(); n++) {
+            xcb_generic_error_t *error = NULL;
+            xcb_query_tree_reply_t *reply = xcb_query_tree_reply(c, cookies.at(n), &error);
+            XcbCalls::checkError(error, "QueryTree");
+            if (reply == NULL) {
+                ret.insert(keys.at(n), None);
+            } else if (reply->parent == reply->root || reply->parent == XCB_WINDOW_NONE) {
+                ret.insert(keys.at(n), pending.value(keys.at(n)));
+            } else {
+                next.insert(keys.at(n), reply->parent);
+            }
+            free(reply);
+        }
+        pending = next;
+    }
+
+    return ret;
+}
+
+Window XcbCalls::getTopLevelWindow(Display *display, Window window)
+{
+    return XcbCalls::getTopLevelWindows(display, QList<Window>() << window).value(window, None);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void XcbCalls::sendClientMessage(Display *display, Window window, const char *messageType, quint32 data0,
+        quint32 data1, quint32 data2, quint32 data3, quint32 data4)
+{
+    LatencyStats::mark(LatencyStats::FIRST_INJECTION);
+
+    xcb_client_message_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.response_type  = XCB_CLIENT_MESSAGE;
+    event.format         = 32;
+    event.window         = window;
+    event.type           = XcbCalls::atom(display, messageType);
+    event.data.data32[0] = data0;
+    event.data.data32[1] = data1;
+    event.data.data32[2] = data2;
+    event.data.data32[3] = data3;
+    event.data.data32[4] = data4;
+
+    xcb_connection_t *c = XcbCalls::connection(display);
+    xcb_send_event(c, false, XConnection::rootWindow(),
+            XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT, (const char *)&event);
+    xcb_flush(c);
+    XCalls::count(1, 0, 1);
+}
+
+
+// ****************************************************************************************************************** //
+// **********                                        PRIVATE METHODS                                       ********** //
+// ****************************************************************************************************************** //
+
+void XcbCalls::checkError(xcb_generic_error_t *error, const char *request)
+{
+    if (error == NULL)
+        return;
+
+    // Usually a BadWindow of a window closed during the gesture
+    qDebug("X error %d in %s (resource 0x%x)", error->error_code, request, error->resource_id);
+    free(error);
+}
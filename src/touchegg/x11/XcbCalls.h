@@ -0,0 +1,140 @@
+/**
+ * @file /src/touchegg/x11/XcbCalls.h
+ *
+ * This file is part of Touchégg.
+ *
+ * Touchégg is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License  as  published by  the  Free Software
+ * Foundation,  either version 2 of the License,  or (at your option)  any later
+ * version.
+ *
+ * Touchégg is distributed in the hope that it will be useful,  but  WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the  GNU General Public License  for more details.
+ *
+ * You should have received a copy of the  GNU General Public License along with
+ * Touchégg. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author José Expósito <jose.exposito89@gmail.com> (C) 2011 - 2012
+ * @class  XcbCalls
+ */
+#ifndef XCBCALLS_H
+#define XCBCALLS_H
+
+#include "src/touchegg/util/Include.h"
+#include "src/touchegg/x11/XCalls.h"
+
+/**
+ * Window queries and EWMH messages made with XCB on the XCB connection of an Xlib Display. Unlike Xlib, XCB returns a
+ * cookie for every request and the reply is waited for later, so several requests can be sent before waiting for the
+ * first reply. For example, getTopLevelWindows() needs one round trip per level of the window tree instead of one per
+ * window and level.
+ *
+ * The requests are counted in the XCalls counters.
+ */
+class XcbCalls
+{
+
+public:
+
+    /**
+     * Returns the XCB connection of a Display.
+     * @param  display The display.
+     * @return The connection.
+     */
+    static xcb_connection_t *connection(Display *display);
+
+    /**
+     * Returns the atom with the indicated name. The atoms are cached, so only the first call for each name makes a
+     * request.
+     * @param  display The display.
+     * @param  name    The name of the atom.
+     * @return The atom.
+     */
+    static xcb_atom_t atom(Display *display, const char *name);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Requests a property with 32 bits format (CARDINAL, WINDOW, ATOM...) without waiting for the reply.
+     * @param  display The display.
+     * @param  window  The window.
+     * @param  name    The name of the property.
+     * @param  type    The type of the property.
+     * @param  length  Maximum number of items to read.
+     * @return The cookie to pass to propertyReply().
+     */
+    static xcb_get_property_cookie_t requestProperty(Display *display, Window window, const char *name,
+            xcb_atom_t type, quint32 length = 65536);
+
+    /**
+     * Waits for the reply of requestProperty().
+     * @param  display The display.
+     * @param  cookie  The cookie returned by requestProperty().
+     * @return The items of the property, empty if it doesn't exist or is not of the requested type.
+     */
+    static QList<quint32> propertyReply(Display *display, xcb_get_property_cookie_t cookie);
+
+    /**
+     * Reads a property with 32 bits format in a single request.
+     * @see requestProperty()
+     */
+    static QList<quint32> getProperty(Display *display, Window window, const char *name, xcb_atom_t type);
+
+    /**
+     * Returns the class of a window (the second string of WM_CLASS), for example, "XTerm" for all the instances of
+     * XTerm.
+     * @param  display The display.
+     * @param  window  The window.
+     * @return The class.
+     */
+    static QString getWindowClass(Display *display, Window window);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Returns the top-level window (the child of the root window) that contains each window. The QueryTree requests of
+     * all the windows are sent before waiting for the replies, level by level.
+     * @param  display The display.
+     * @param  windows The windows.
+     * @return The top-level window of each window, None if the window doesn't exist.
+     */
+    static QHash<Window, Window> getTopLevelWindows(Display *display, const QList<Window> &windows);
+
+    /**
+     * Returns the top-level window that contains a window.
+     * @see getTopLevelWindows()
+     */
+    static Window getTopLevelWindow(Display *display, Window window);
+
+    //------------------------------------------------------------------------------------------------------------------
+
+    /**
+     * Sends an EWMH client message to the root window and flushes the connection.
+     * @param display     The display.
+     * @param window      The window the message refers to.
+     * @param messageType Name of the atom of the message type.
+     * @param data0..4    The data of the message.
+     */
+    static void sendClientMessage(Display *display, Window window, const char *messageType, quint32 data0,
+            quint32 data1 = 0, quint32 data2 = 0, quint32 data3 = 0, quint32 data4 = 0);
+
+private:
+
+    /**
+     * Logs and frees the error of a reply, if any. The errors of the replies are read here and not by the error handler
+     * of Xlib, see XConnection::installErrorHandler(), that receives the errors of the requests without reply.
+     * @param error   The error or NULL.
+     * @param request Name of the request, for the log.
+     */
+    static void checkError(xcb_generic_error_t *error, const char *request);
+
+    /**
+     * Cache of atoms by name, shared by all the connections because the atoms belong to the server.
+     */
+    static QHash<QByteArray, xcb_atom_t> atoms;
+    static QMutex atomsMutex;
+
+};
+
+#endif // XCBCALLS_H
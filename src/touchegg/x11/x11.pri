@@ -0,0 +1,9 @@
+HEADERS += \
+    src/touchegg/x11/XCalls.h \
+    src/touchegg/x11/XcbCalls.h \
+    src/touchegg/x11/XConnection.h
+
+SOURCES += \
+    src/touchegg/x11/XCalls.cpp \
+    src/touchegg/x11/XcbCalls.cpp \
+    src/touchegg/x11/XConnection.cpp
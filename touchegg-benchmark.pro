@@ -0,0 +1,33 @@
+TEMPLATE     = app
+TARGET       = touchegg-benchmark
+QT           = core
+CONFIG      += console
+
+DEFINES      = QT_NO_DEBUG_OUTPUT
+
+# Xlib, XTest, XRandR and XCB are replaced by src/benchmark/FakeX11.cpp and only the headers of GEIS are used, so
+# LIBS is empty
+
+include(src/touchegg/util/util.pri)
+include(src/touchegg/config/config.pri)
+include(src/touchegg/stats/stats.pri)
+include(src/touchegg/x11/x11.pri)
+include(src/touchegg/eventloop/eventloop.pri)
+include(src/touchegg/windows/windows.pri)
+include(src/touchegg/devices/devices.pri)
+include(src/touchegg/monitors/monitors.pri)
+include(src/touchegg/launcher/launcher.pri)
+
+include(src/touchegg/gestures/handler/gestures.handler.pri)
+include(src/touchegg/gestures/classifier/gestures.classifier.pri)
+include(src/touchegg/gestures/tap/gestures.tap.pri)
+include(src/touchegg/gestures/factory/gestures.factory.pri)
+include(src/touchegg/gestures/implementation/gestures.implementation.pri)
+include(src/touchegg/gestures/types/gestures.types.pri)
+
+include(src/touchegg/actions/types/actions.types.pri)
+include(src/touchegg/actions/factory/actions.factory.pri)
+include(src/touchegg/actions/injector/actions.injector.pri)
+include(src/touchegg/actions/implementation/actions.implementation.pri)
+
+include(src/benchmark/benchmark.pri)
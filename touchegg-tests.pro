@@ -0,0 +1,11 @@
+TEMPLATE     = app
+TARGET       = touchegg-tests
+QT           = core testlib
+CONFIG      += console
+
+# Only the headers of Xlib and GEIS are used by the tested classes, so LIBS is empty
+
+include(src/touchegg/util/util.pri)
+include(src/touchegg/gestures/tap/gestures.tap.pri)
+
+include(src/tests/tests.pri)
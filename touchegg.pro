@@ -1,7 +1,7 @@
 TEMPLATE     = app
 TARGET       = touchegg
-QT          += gui core xml
-LIBS        += -lgeis -lX11 -lXtst -lXext
+QT           = core
+LIBS        += -lgeis -lX11 -lXtst -lXext -lXrandr -lxcb -lX11-xcb
 //DEFINES      = QT_NO_DEBUG_OUTPUT
 
 target.path  = /usr/bin